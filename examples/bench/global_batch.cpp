@@ -0,0 +1,73 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+// many application threads submit tiny tasks to the global queue - reports
+// the throughput and how many tasks a worker-thread moved per dequeue
+
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+
+#include <boost/atomic.hpp>
+#include <boost/bind.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/thread.hpp>
+
+#include "boost/task/all.hpp"
+
+namespace pt = boost::posix_time;
+namespace tsk = boost::tasks;
+
+typedef tsk::static_pool< tsk::unbounded_fifo > pool_type;
+
+boost::atomic< long > counter( 0);
+
+void tiny()
+{ counter.fetch_add( 1, boost::memory_order_relaxed); }
+
+void produce( pool_type & pool, long n)
+{
+	for ( long i = 0; i < n; ++i)
+		tsk::async( tiny, pool);
+}
+
+int main( int argc, char *argv[])
+{
+	try
+	{
+		int producers = 1 < argc ? std::atoi( argv[1]) : 8;
+		long n = 2 < argc ? std::atol( argv[2]) : 200000;
+
+		pool_type pool( tsk::poolsize( boost::thread::hardware_concurrency() ) );
+
+		pt::ptime start = pt::microsec_clock::universal_time();
+		boost::thread_group producer;
+		for ( int i = 0; i < producers; ++i)
+			producer.create_thread( boost::bind( produce, boost::ref( pool), n) );
+		producer.join_all();
+		while ( counter.load() < producers * n)
+			boost::this_thread::yield();
+		pt::time_duration elapsed = pt::microsec_clock::universal_time() - start;
+
+		tsk::statistics st( pool.statistics() );
+		std::cout << producers << " producers, " << producers * n << " tasks: "
+			<< elapsed.total_milliseconds() << " ms, "
+			<< producers * n * 1000. / elapsed.total_microseconds() << " tasks/ms, "
+			<< st.global_takes << " dequeues, "
+			<< ( st.global_takes ? double( st.global_taken) / st.global_takes : 0.)
+			<< " tasks/dequeue" << std::endl;
+
+		pool.shutdown();
+
+		return EXIT_SUCCESS;
+	}
+	catch ( std::exception const& e)
+	{ std::cerr << "exception: " << e.what() << std::endl; }
+	catch ( ... )
+	{ std::cerr << "unhandled" << std::endl; }
+
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,97 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+// compares joining sub-tasks by suspending the waiting task with joining
+// by executing other work while waiting - deep recursion, tight cutoffs
+
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+
+#include <boost/bind.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/thread.hpp>
+
+#include "boost/task/all.hpp"
+
+namespace pt = boost::posix_time;
+namespace tsk = boost::tasks;
+
+typedef tsk::static_pool< tsk::unbounded_fifo > pool_type;
+
+long serial_fib( long n)
+{
+	if( n < 2)
+		return n;
+	else
+		return serial_fib( n - 1) + serial_fib( n - 2);
+}
+
+long parallel_fib( long n, long cutof)
+{
+	if ( n < cutof)
+		return serial_fib( n);
+	else
+	{
+		tsk::task< long > t1(
+			tsk::fork( boost::bind( parallel_fib, n - 1, cutof) ) );
+		tsk::task< long > t2(
+			tsk::fork( boost::bind( parallel_fib, n - 2, cutof) ) );
+		return t1.get() + t2.get();
+	}
+}
+
+void run( pool_type & pool, bool help, long n, long cutof, int rounds)
+{
+	pool.help_while_waiting( help);
+	tsk::statistics before( pool.statistics() );
+
+	pt::ptime start = pt::microsec_clock::universal_time();
+	for ( int i = 0; i < rounds; ++i)
+	{
+		tsk::task< long > t(
+			tsk::async( boost::bind( parallel_fib, n, cutof), pool) );
+		t.get();
+	}
+	pt::time_duration elapsed = pt::microsec_clock::universal_time() - start;
+
+	tsk::statistics after( pool.statistics() );
+
+	std::cout << "cutoff " << cutof << ( help ? ", help:    " : ", suspend: ")
+		<< elapsed.total_milliseconds() << " ms, "
+		<< rounds * 1000000. / elapsed.total_microseconds() << " fib/s, "
+		<< after.helped - before.helped << " helped, "
+		<< after.stacks_mapped - before.stacks_mapped << " stacks mapped" << std::endl;
+}
+
+int main( int argc, char *argv[])
+{
+	try
+	{
+		long n = 1 < argc ? std::atol( argv[1]) : 30;
+		int rounds = 2 < argc ? std::atoi( argv[2]) : 5;
+
+		pool_type pool( tsk::poolsize( boost::thread::hardware_concurrency() ) );
+
+		// warm up
+		run( pool, true, n, 12, 1);
+
+		// the tighter the cutoff, the more sub-tasks wait for their children
+		for ( long cutof = 12; cutof >= 2; cutof -= 5)
+		{
+			run( pool, false, n, cutof, rounds);
+			run( pool, true, n, cutof, rounds);
+		}
+
+		return EXIT_SUCCESS;
+	}
+	catch ( std::exception const& e)
+	{ std::cerr << "exception: " << e.what() << std::endl; }
+	catch ( ... )
+	{ std::cerr << "unhandled" << std::endl; }
+
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,80 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+// tiny tasks executed by static_pool and by a basic_pool stripped of
+// run-time switches, interruption support and instrumentation (random
+// instead of hierarchical stealing) - reports the throughput of both
+// configurations
+
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+
+#include <boost/atomic.hpp>
+#include <boost/bind.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/thread.hpp>
+
+#include "boost/task/all.hpp"
+
+namespace pt = boost::posix_time;
+namespace tsk = boost::tasks;
+
+typedef tsk::static_pool< tsk::unbounded_fifo >								default_pool;
+typedef tsk::basic_pool< tsk::unbounded_fifo, tsk::stripped_pool_policy >	stripped_pool;
+
+boost::atomic< long > counter( 0);
+
+void tiny()
+{ counter.fetch_add( 1, boost::memory_order_relaxed); }
+
+// each task spawns a second one from inside the pool, so that the
+// worker-queues are exercised too
+template< typename Pool >
+void spawn( Pool * pool)
+{
+	tiny();
+	tsk::async( tiny, * pool);
+}
+
+template< typename Pool >
+void run( char const* name, long n)
+{
+	Pool pool( tsk::poolsize( boost::thread::hardware_concurrency() ) );
+	counter.store( 0);
+
+	pt::ptime start = pt::microsec_clock::universal_time();
+	for ( long i = 0; i < n; ++i)
+		tsk::async( boost::bind( spawn< Pool >, & pool), pool);
+	while ( counter.load() < 2 * n)
+		boost::this_thread::yield();
+	pt::time_duration elapsed = pt::microsec_clock::universal_time() - start;
+
+	std::cout << name << ": " << 2 * n << " tasks, "
+		<< elapsed.total_milliseconds() << " ms, "
+		<< 2 * n * 1000. / elapsed.total_microseconds() << " tasks/ms" << std::endl;
+
+	pool.shutdown();
+}
+
+int main( int argc, char *argv[])
+{
+	try
+	{
+		long n = 1 < argc ? std::atol( argv[1]) : 200000;
+
+		run< default_pool >( "static_pool", n);
+		run< stripped_pool >( "basic_pool< stripped_pool_policy >", n);
+
+		return EXIT_SUCCESS;
+	}
+	catch ( std::exception const& e)
+	{ std::cerr << "exception: " << e.what() << std::endl; }
+	catch ( ... )
+	{ std::cerr << "unhandled" << std::endl; }
+
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,77 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+// many application threads submit tiny tasks - compares the global
+// unbounded_fifo with a sharded_fifo
+
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+
+#include <boost/atomic.hpp>
+#include <boost/bind.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/thread.hpp>
+
+#include "boost/task/all.hpp"
+
+namespace pt = boost::posix_time;
+namespace tsk = boost::tasks;
+
+boost::atomic< long > counter( 0);
+
+void tiny()
+{ counter.fetch_add( 1, boost::memory_order_relaxed); }
+
+template< typename Pool >
+void produce( Pool & pool, long n)
+{
+	for ( long i = 0; i < n; ++i)
+		tsk::async( tiny, pool);
+}
+
+template< typename Pool >
+pt::time_duration run( int producers, long n)
+{
+	counter.store( 0);
+	Pool pool( tsk::poolsize( boost::thread::hardware_concurrency() ) );
+
+	pt::ptime start = pt::microsec_clock::universal_time();
+	boost::thread_group producer;
+	for ( int i = 0; i < producers; ++i)
+		producer.create_thread( boost::bind( produce< Pool >, boost::ref( pool), n) );
+	producer.join_all();
+	while ( counter.load() < producers * n)
+		boost::this_thread::yield();
+	pt::time_duration elapsed = pt::microsec_clock::universal_time() - start;
+
+	pool.shutdown();
+	return elapsed;
+}
+
+int main( int argc, char *argv[])
+{
+	try
+	{
+		int producers = 1 < argc ? std::atoi( argv[1]) : 32;
+		long n = 2 < argc ? std::atol( argv[2]) : 100000;
+
+		pt::time_duration global( run< tsk::static_pool< tsk::unbounded_fifo > >( producers, n) );
+		pt::time_duration sharded( run< tsk::static_pool< tsk::sharded_fifo > >( producers, n) );
+
+		std::cout << producers << " producers, " << producers * n << " tasks: unbounded_fifo "
+			<< global.total_milliseconds() << " ms, sharded_fifo "
+			<< sharded.total_milliseconds() << " ms" << std::endl;
+
+		return EXIT_SUCCESS;
+	}
+	catch ( std::exception const& e)
+	{ std::cerr << "exception: " << e.what() << std::endl; }
+	catch ( ... )
+	{ std::cerr << "unhandled" << std::endl; }
+
+	return EXIT_FAILURE;
+}
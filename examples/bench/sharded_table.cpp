@@ -0,0 +1,110 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+// updates of an in-memory table split into shards - each task updates
+// entries of one shard; the tasks are submitted to the global queue or
+// with the shard as affinity hint, so that a shard stays in the cache
+// of one worker-thread
+
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/atomic.hpp>
+#include <boost/bind.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/ptr_container/ptr_vector.hpp>
+#include <boost/thread.hpp>
+
+#include "boost/task/all.hpp"
+
+namespace pt = boost::posix_time;
+namespace tsk = boost::tasks;
+
+typedef tsk::static_pool< tsk::unbounded_fifo > pool_type;
+
+struct shard
+{
+	boost::mutex		mtx;
+	std::vector< long >	entries;
+
+	shard( std::size_t size) :
+		mtx(), entries( size, 0)
+	{}
+};
+
+boost::ptr_vector< shard > table;
+boost::atomic< long > counter( 0);
+
+void update( std::size_t s, unsigned int seed, std::size_t n)
+{
+	shard & sh( table[s]);
+	boost::mutex::scoped_lock lk( sh.mtx);
+	std::size_t size( sh.entries.size() );
+	for ( std::size_t i = 0; i < n; ++i)
+	{
+		seed = seed * 1103515245 + 12345;
+		sh.entries[seed % size] += 1;
+	}
+	counter.fetch_add( 1, boost::memory_order_relaxed);
+}
+
+pt::time_duration run( pool_type & pool, long tasks, std::size_t shards, bool hinted)
+{
+	counter.store( 0);
+	pt::ptime start = pt::microsec_clock::universal_time();
+	for ( long i = 0; i < tasks; ++i)
+	{
+		std::size_t s( ( i * 7) % shards);
+		if ( hinted)
+			pool.submit( boost::bind( update, s, i, 256), tsk::affinity::by_key( s) );
+		else
+			pool.submit( boost::bind( update, s, i, 256) );
+	}
+	while ( counter.load() < tasks)
+		boost::this_thread::yield();
+	return pt::microsec_clock::universal_time() - start;
+}
+
+int main( int argc, char *argv[])
+{
+	try
+	{
+		std::size_t shards = 1 < argc ? std::atoi( argv[1]) : 64;
+		std::size_t shard_size = 2 < argc ? std::atoi( argv[2]) : 32 * 1024;
+		long tasks = 3 < argc ? std::atol( argv[3]) : 100000;
+
+		for ( std::size_t i = 0; i < shards; ++i)
+			table.push_back( new shard( shard_size) );
+
+		pool_type pool( tsk::poolsize( boost::thread::hardware_concurrency() ) );
+
+		// warm up
+		run( pool, tasks / 10, shards, false);
+
+		pt::time_duration global( run( pool, tasks, shards, false) );
+		tsk::statistics before( pool.statistics() );
+		pt::time_duration hinted( run( pool, tasks, shards, true) );
+		tsk::statistics after( pool.statistics() );
+
+		std::cout << shards << " shards of " << shard_size << " entries, " << tasks << " tasks: global queue "
+			<< global.total_milliseconds() << " ms, affinity "
+			<< hinted.total_milliseconds() << " ms ("
+			<< after.posted - before.posted << " on the chosen worker-thread, "
+			<< after.posted_stolen - before.posted_stolen << " stolen)" << std::endl;
+
+		pool.shutdown();
+
+		return EXIT_SUCCESS;
+	}
+	catch ( std::exception const& e)
+	{ std::cerr << "exception: " << e.what() << std::endl; }
+	catch ( ... )
+	{ std::cerr << "unhandled" << std::endl; }
+
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,103 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+// compares uniform random victim selection with hierarchical
+// (SMT sibling, last-level cache, NUMA node, remote) victim selection
+// for a fork/join workload
+
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+
+#include <boost/bind.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/ref.hpp>
+#include <boost/thread.hpp>
+
+#include "boost/task/all.hpp"
+
+namespace pt = boost::posix_time;
+namespace tsk = boost::tasks;
+
+typedef tsk::static_pool< tsk::unbounded_fifo > pool_type;
+
+long serial_fib( long n)
+{
+	if( n < 2)
+		return n;
+	else
+		return serial_fib( n - 1) + serial_fib( n - 2);
+}
+
+void parallel_fib( long n, long cutof, long & result)
+{
+	if ( n < cutof)
+		result = serial_fib( n);
+	else
+	{
+		long r1( 0), r2( 0);
+		tsk::task< void > t1(
+			tsk::fork( boost::bind( parallel_fib, n - 1, cutof, boost::ref( r1) ) ) );
+		tsk::task< void > t2(
+			tsk::fork( boost::bind( parallel_fib, n - 2, cutof, boost::ref( r2) ) ) );
+		t1.wait();
+		t2.wait();
+		result = r1 + r2;
+	}
+}
+
+void run( pool_type & pool, bool hierarchical, long n, long cutof, int rounds)
+{
+	pool.topology_aware( hierarchical);
+	tsk::statistics before( pool.statistics() );
+
+	pt::ptime start = pt::microsec_clock::universal_time();
+	for ( int i = 0; i < rounds; ++i)
+	{
+		long result( 0);
+		tsk::task< void > t(
+			tsk::async( boost::bind( parallel_fib, n, cutof, boost::ref( result) ), pool) );
+		t.wait();
+	}
+	pt::time_duration elapsed = pt::microsec_clock::universal_time() - start;
+
+	tsk::statistics after( pool.statistics() );
+	std::size_t steals = after.steals - before.steals;
+	std::size_t remote = after.remote_steals - before.remote_steals;
+
+	std::cout << ( hierarchical ? "hierarchical: " : "random:       ")
+		<< elapsed.total_milliseconds() << " ms, "
+		<< rounds * 1000000. / elapsed.total_microseconds() << " fib/s, "
+		<< steals << " steals, "
+		<< remote << " remote ("
+		<< ( steals ? 100. * remote / steals : 0.) << "%)" << std::endl;
+}
+
+int main( int argc, char *argv[])
+{
+	try
+	{
+		long n = 1 < argc ? std::atol( argv[1]) : 32;
+		long cutof = 2 < argc ? std::atol( argv[2]) : 12;
+		int rounds = 3 < argc ? std::atoi( argv[3]) : 10;
+
+		pool_type pool( tsk::poolsize( boost::thread::hardware_concurrency() ) );
+
+		// warm up
+		run( pool, false, n, cutof, 1);
+
+		run( pool, false, n, cutof, rounds);
+		run( pool, true, n, cutof, rounds);
+
+		return EXIT_SUCCESS;
+	}
+	catch ( std::exception const& e)
+	{ std::cerr << "exception: " << e.what() << std::endl; }
+	catch ( ... )
+	{ std::cerr << "unhandled" << std::endl; }
+
+	return EXIT_FAILURE;
+}
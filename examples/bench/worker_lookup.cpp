@@ -0,0 +1,79 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+// measures the overhead of the worker lookup done in each iteration of
+// the spin primitives' wait loops - the native thread-local descriptor
+// against a thread_specific_ptr lookup (the former implementation)
+
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+
+#include <boost/bind.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/thread.hpp>
+
+#include "boost/task/all.hpp"
+
+namespace pt = boost::posix_time;
+namespace tsk = boost::tasks;
+
+typedef tsk::static_pool< tsk::unbounded_fifo > pool_type;
+
+boost::thread_specific_ptr< int >	tss;
+
+// keeps the compiler from dropping the lookups
+volatile long sink = 0;
+
+bool tss_lookup()
+{ return tss.get() != 0; }
+
+bool tls_lookup()
+{ return boost::this_task::runs_in_pool(); }
+
+// emulates a spin-wait loop which checks in each iteration
+// whether it runs inside the pool
+double spin( bool ( * lookup)(), long iterations)
+{
+	long hits = 0;
+	pt::ptime start = pt::microsec_clock::universal_time();
+	for ( long i = 0; i < iterations; ++i)
+		if ( lookup() ) ++hits;
+	pt::time_duration elapsed = pt::microsec_clock::universal_time() - start;
+	sink += hits;
+	return double( elapsed.total_microseconds() * 1000) / iterations;
+}
+
+void report( char const* where, long iterations)
+{
+	std::cout << where << ": thread_specific_ptr "
+		<< spin( tss_lookup, iterations) << " ns/iteration, thread-local descriptor "
+		<< spin( tls_lookup, iterations) << " ns/iteration" << std::endl;
+}
+
+int main( int argc, char *argv[])
+{
+	try
+	{
+		long iterations = 1 < argc ? std::atol( argv[1]) : 100000000;
+
+		tss.reset( new int( 0) );
+		report( "application thread", iterations);
+
+		pool_type pool( tsk::poolsize( 1) );
+		tsk::task< void > t(
+			tsk::async( boost::bind( report, "worker-thread", iterations), pool) );
+		t.wait();
+
+		return EXIT_SUCCESS;
+	}
+	catch ( std::exception const& e)
+	{ std::cerr << "exception: " << e.what() << std::endl; }
+	catch ( ... )
+	{ std::cerr << "unhandled" << std::endl; }
+
+	return EXIT_FAILURE;
+}
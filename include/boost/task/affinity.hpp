@@ -0,0 +1,56 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_TASKS_AFFINITY_H
+#define BOOST_TASKS_AFFINITY_H
+
+#include <cstddef>
+
+#include <boost/functional/hash.hpp>
+
+#include <boost/task/detail/config.hpp>
+
+# if defined(BOOST_MSVC)
+# pragma warning(push)
+# pragma warning(disable:4251 4275)
+# endif
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_PREFIX
+#endif
+
+namespace boost {
+namespace tasks {
+
+// hint which worker-thread should execute a task - the value is taken
+// modulo the number of worker-threads, so tasks with the same key run
+// on the same worker-thread as long as it is not overloaded
+class BOOST_TASK_DECL affinity
+{
+private:
+	std::size_t	value_;
+
+public:
+	explicit affinity( std::size_t index);
+
+	template< typename Key >
+	static affinity by_key( Key const& key)
+	{ return affinity( hash< Key >()( key) ); }
+
+	operator std::size_t () const;
+};
+
+}}
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_SUFFIX
+#endif
+
+# if defined(BOOST_MSVC)
+# pragma warning(pop)
+# endif
+
+#endif // BOOST_TASKS_AFFINITY_H
@@ -7,23 +7,36 @@
 #ifndef BOOST_TASK_ALL_H
 #define BOOST_TASK_ALL_H
 
+#include <boost/task/affinity.hpp>
 #include <boost/task/async.hpp>
+#include <boost/task/basic_pool.hpp>
 #include <boost/task/bounded_fifo.hpp>
 #include <boost/task/callable.hpp>
 #include <boost/task/context.hpp>
+#include <boost/task/dynamic_pool.hpp>
 #include <boost/task/exceptions.hpp>
+#include <boost/task/fairness_tick.hpp>
 #include <boost/task/fast_semaphore.hpp>
 #include <boost/task/fork.hpp>
+#include <boost/task/idle_strategy.hpp>
+#include <boost/task/latency_lanes.hpp>
 #include <boost/task/meta.hpp>
 #include <boost/task/new_thread.hpp>
 #include <boost/task/own_thread.hpp>
+#include <boost/task/pool_policy.hpp>
 #include <boost/task/poolsize.hpp>
+#include <boost/task/processor_set.hpp>
 #include <boost/task/semaphore.hpp>
+#include <boost/task/sharded_fifo.hpp>
 #include <boost/task/stacksize.hpp>
 #include <boost/task/static_pool.hpp>
+#include <boost/task/statistics.hpp>
+#include <boost/task/steal_batch.hpp>
+#include <boost/task/strand.hpp>
 #include <boost/task/task.hpp>
 #include <boost/task/unbounded_fifo.hpp>
 #include <boost/task/utility.hpp>
 #include <boost/task/watermark.hpp>
+#include <boost/task/worker_capacity.hpp>
 
 #endif // BOOST_TASK_ALL_H
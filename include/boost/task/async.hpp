@@ -13,6 +13,8 @@
 #include <boost/move/move.hpp>
 #include <boost/result_of.hpp>
 
+#include <boost/task/basic_pool.hpp>
+#include <boost/task/dynamic_pool.hpp>
 #include <boost/task/new_thread.hpp>
 #include <boost/task/own_thread.hpp>
 #include <boost/task/static_pool.hpp>
@@ -55,24 +57,25 @@ task< typename result_of< Fn() >::result_type >
 async( BOOST_RV_REF( Fn) fn, new_thread nt)
 { return nt( boost::move( fn) ); }
 
-template< typename Fn, typename Queue >
+// static_pool and dynamic_pool are basic_pools
+template< typename Fn, typename Queue, typename Policy >
 task< typename result_of< Fn() >::result_type >
-async( Fn fn, static_pool< Queue > & pool)
+async( Fn fn, basic_pool< Queue, Policy > & pool)
 { return pool.submit( fn); }
 
-template< typename Fn, typename Queue >
+template< typename Fn, typename Queue, typename Policy >
 task< typename result_of< Fn() >::result_type >
-async( BOOST_RV_REF( Fn) fn, static_pool< Queue > & pool)
+async( BOOST_RV_REF( Fn) fn, basic_pool< Queue, Policy > & pool)
 { return pool.submit( boost::move( fn) ); }
 
-template< typename Fn, typename Attr, typename Queue >
+template< typename Fn, typename Attr, typename Queue, typename Policy >
 task< typename result_of< Fn() >::result_type >
-async( Fn fn, Attr attr, static_pool< Queue > & pool)
+async( Fn fn, Attr attr, basic_pool< Queue, Policy > & pool)
 { return pool.submit( fn, attr); }
 
-template< typename Fn, typename Attr, typename Queue >
+template< typename Fn, typename Attr, typename Queue, typename Policy >
 task< typename result_of< Fn() >::result_type >
-async( BOOST_RV_REF( Fn) fn, Attr attr, static_pool< Queue > & pool)
+async( BOOST_RV_REF( Fn) fn, Attr attr, basic_pool< Queue, Policy > & pool)
 { return pool.submit( boost::move( fn), attr); }
 
 }}
@@ -0,0 +1,414 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_TASKS_BASIC_POOL_H
+#define BOOST_TASKS_BASIC_POOL_H
+
+#include <cstddef>
+
+#include <boost/config.hpp>
+#include <boost/context/stack_utils.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/move/move.hpp>
+#include <boost/result_of.hpp>
+#include <boost/static_assert.hpp>
+
+#include <boost/task/affinity.hpp>
+#include <boost/task/detail/pool_base.hpp>
+#include <boost/task/detail/worker_group.hpp>
+#include <boost/task/exceptions.hpp>
+#include <boost/task/fairness_tick.hpp>
+#include <boost/task/idle_strategy.hpp>
+#include <boost/task/latency_lanes.hpp>
+#include <boost/task/pool_policy.hpp>
+#include <boost/task/poolsize.hpp>
+#include <boost/task/processor_set.hpp>
+#include <boost/task/stacksize.hpp>
+#include <boost/task/statistics.hpp>
+#include <boost/task/steal_batch.hpp>
+#include <boost/task/task.hpp>
+#include <boost/task/watermark.hpp>
+#include <boost/task/worker_capacity.hpp>
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_PREFIX
+#endif
+
+namespace boost {
+namespace tasks {
+
+// thread-pool whose scheduling components are selected at compile time
+// by a pool_policy - unused components are not instantiated
+// the bounds, the attribute overloads of submit() and the lanes may only
+// be used with a bounded queue respective a queue with attributes
+// a pool with variable_size is constructed from a minimum and a maximum
+// size, the other pools from a size or a set of processors
+template< typename Queue, typename Policy = default_pool_policy >
+class basic_pool
+{
+public:
+	typedef Queue	queue_type;
+	typedef Policy	policy_type;
+
+private:
+	typedef detail::pool_base< queue_type, policy_type >     base_type;
+
+	BOOST_MOVABLE_BUT_NOT_COPYABLE( basic_pool);	
+
+    typename base_type::ptr_t                    		pool_;
+
+public:
+    typedef void ( * unspecified_bool_type)( basic_pool ***);
+
+    static void unspecified_bool( basic_pool ***) {}
+
+	basic_pool() :
+		pool_()
+	{}
+	
+	explicit basic_pool(
+			poolsize const& psize,
+			stacksize const& stack_size = stacksize( ctx::default_stacksize() ) ) :
+		pool_( new base_type( detail::pool_settings( psize), stack_size) )
+	{ BOOST_STATIC_ASSERT( ! Policy::resizable); }
+
+# if defined(BOOST_HAS_PROCESSOR_BINDINGS)
+	// one worker-thread per CPU the calling thread may run on
+	static processor_set bind_to_processors()
+	{ return processor_set(); }
+
+	explicit basic_pool(
+			processor_set const& cpus,
+			stacksize const& stack_size = stacksize( ctx::default_stacksize() ) ) :
+		pool_( new base_type( detail::pool_settings( cpus), stack_size) )
+	{ BOOST_STATIC_ASSERT( ! Policy::resizable); }
+# endif
+
+	explicit basic_pool(
+			poolsize const& psize,
+			high_watermark const& hwm,
+			low_watermark const& lwm,
+			stacksize const& stack_size = stacksize( ctx::default_stacksize() ) ) :
+		pool_( new base_type( detail::pool_settings( psize), hwm, lwm, stack_size) )
+	{ BOOST_STATIC_ASSERT( ! Policy::resizable); }
+
+# if defined(BOOST_HAS_PROCESSOR_BINDINGS)
+	explicit basic_pool(
+			processor_set const& cpus,
+			high_watermark const& hwm,
+			low_watermark const& lwm,
+			stacksize const& stack_size = stacksize( ctx::default_stacksize() ) ) :
+		pool_( new base_type( detail::pool_settings( cpus), hwm, lwm, stack_size) )
+	{ BOOST_STATIC_ASSERT( ! Policy::resizable); }
+# endif
+
+	basic_pool(
+			poolsize const& min_size,
+			poolsize const& max_size,
+			posix_time::time_duration const& keep_alive = posix_time::seconds( 60),
+			posix_time::time_duration const& max_latency = posix_time::milliseconds( 10),
+			stacksize const& stack_size = stacksize( ctx::default_stacksize() ) ) :
+		pool_( new base_type(
+			detail::pool_settings( min_size, max_size, keep_alive, max_latency),
+			stack_size) )
+	{ BOOST_STATIC_ASSERT( Policy::resizable); }
+
+	basic_pool(
+			poolsize const& min_size,
+			poolsize const& max_size,
+			high_watermark const& hwm,
+			low_watermark const& lwm,
+			posix_time::time_duration const& keep_alive = posix_time::seconds( 60),
+			posix_time::time_duration const& max_latency = posix_time::milliseconds( 10),
+			stacksize const& stack_size = stacksize( ctx::default_stacksize() ) ) :
+		pool_( new base_type(
+			detail::pool_settings( min_size, max_size, keep_alive, max_latency),
+			hwm, lwm, stack_size) )
+	{ BOOST_STATIC_ASSERT( Policy::resizable); }
+
+	basic_pool( BOOST_RV_REF( basic_pool) other) :
+		pool_()
+	{ pool_.swap( other.pool_); }
+
+	basic_pool & operator=( BOOST_RV_REF( basic_pool) other)
+	{
+		basic_pool tmp( boost::move( other) );
+		swap( tmp);
+		return * this;
+	}
+
+	operator unspecified_bool_type() const // throw()
+	{ return pool_; }
+
+	bool operator!() const // throw()
+	{ return ! pool_; }
+
+	void swap( basic_pool & other) // throw()
+	{ pool_.swap( other.pool_); }
+
+	void interrupt_all_worker()
+	{
+        BOOST_ASSERT( pool_);
+		pool_->interrupt_all_worker();
+	}
+
+	void shutdown()
+	{
+        BOOST_ASSERT( pool_);
+		pool_->shutdown();
+	}
+
+	const void shutdown_now()
+	{
+        BOOST_ASSERT( pool_);
+		pool_->shutdown_now();
+	}
+
+	std::size_t size() const
+	{
+        BOOST_ASSERT( pool_);
+		return pool_->size();
+	}
+
+	// only available with variable_size
+	std::size_t min_size() const
+	{
+		BOOST_STATIC_ASSERT( Policy::resizable);
+        BOOST_ASSERT( pool_);
+		return pool_->min_size();
+	}
+
+	std::size_t max_size() const
+	{
+		BOOST_STATIC_ASSERT( Policy::resizable);
+        BOOST_ASSERT( pool_);
+		return pool_->max_size();
+	}
+
+	bool closed() const
+	{
+        BOOST_ASSERT( pool_);
+		return pool_->closed();
+	}
+
+	std::size_t steal_batch_size() const
+	{
+        BOOST_ASSERT( pool_);
+		return pool_->steal_batch_size();
+	}
+
+	void steal_batch_size( steal_batch const& sb)
+	{
+        BOOST_ASSERT( pool_);
+		pool_->steal_batch_size( sb);
+	}
+
+	std::size_t worker_queue_capacity() const
+	{
+        BOOST_ASSERT( pool_);
+		return pool_->worker_queue_capacity();
+	}
+
+	void worker_queue_capacity( worker_capacity const& wc)
+	{
+        BOOST_ASSERT( pool_);
+		pool_->worker_queue_capacity( wc);
+	}
+
+	std::size_t stack_cache_size() const
+	{
+        BOOST_ASSERT( pool_);
+		return pool_->stack_cache_size();
+	}
+
+	void stack_cache_size( std::size_t n)
+	{
+        BOOST_ASSERT( pool_);
+		pool_->stack_cache_size( n);
+	}
+
+	fairness_tick fairness() const
+	{
+        BOOST_ASSERT( pool_);
+		return pool_->fairness();
+	}
+
+	void fairness( fairness_tick const& ft)
+	{
+        BOOST_ASSERT( pool_);
+		pool_->fairness( ft);
+	}
+
+	// a fixed idle strategy is reported with the window of the pool
+	idle_strategy idle() const
+	{
+        BOOST_ASSERT( pool_);
+		if ( 0 > Policy::idle_mode) return pool_->idle();
+		return idle_strategy(
+			static_cast< idle_strategy::mode >( Policy::idle_mode),
+			pool_->idle().window() );
+	}
+
+	// only available with runtime_idle - a fixed idle strategy
+	// can not be changed
+	void idle( idle_strategy const& is)
+	{
+		BOOST_STATIC_ASSERT( 0 > Policy::idle_mode);
+        BOOST_ASSERT( pool_);
+		pool_->idle( is);
+	}
+
+	bool topology_aware() const
+	{
+        BOOST_ASSERT( pool_);
+		return Policy::topology && pool_->topology_aware();
+	}
+
+	// only available with hierarchical_steal - the other steal
+	// strategies do not query the topology
+	void topology_aware( bool value)
+	{
+		BOOST_STATIC_ASSERT( Policy::topology);
+        BOOST_ASSERT( pool_);
+		pool_->topology_aware( value);
+	}
+
+	bool lazy_fibers() const
+	{
+        BOOST_ASSERT( pool_);
+		return pool_->lazy_fibers();
+	}
+
+	void lazy_fibers( bool value)
+	{
+        BOOST_ASSERT( pool_);
+		pool_->lazy_fibers( value);
+	}
+
+	bool help_while_waiting() const
+	{
+        BOOST_ASSERT( pool_);
+		return pool_->help_while_waiting();
+	}
+
+	void help_while_waiting( bool value)
+	{
+        BOOST_ASSERT( pool_);
+		pool_->help_while_waiting( value);
+	}
+
+	bool local_submission() const
+	{
+        BOOST_ASSERT( pool_);
+		return pool_->local_submission();
+	}
+
+	void local_submission( bool value)
+	{
+        BOOST_ASSERT( pool_);
+		pool_->local_submission( value);
+	}
+
+	std::size_t lanes() const
+	{
+        BOOST_ASSERT( pool_);
+		return pool_->lanes();
+	}
+
+	// not available with variable_size - a lane worker-thread could
+	// be retired
+	template< typename Attr >
+	void lanes( latency_lanes< Attr > const& ll)
+	{
+		BOOST_STATIC_ASSERT( ! Policy::resizable);
+        BOOST_ASSERT( pool_);
+		pool_->lanes( ll);
+	}
+
+	tasks::statistics statistics() const
+	{
+        BOOST_ASSERT( pool_);
+		return pool_->statistics();
+	}
+
+	std::size_t upper_bound() const
+	{
+        BOOST_ASSERT( pool_);
+		return pool_->upper_bound();
+	}
+
+	void upper_bound( high_watermark const& hwm)
+	{
+        BOOST_ASSERT( pool_);
+		pool_->upper_bound( hwm);
+	}
+
+	std::size_t lower_bound() const
+	{
+        BOOST_ASSERT( pool_);
+		return pool_->lower_bound();
+	}
+
+	void lower_bound( low_watermark const lwm)
+	{
+        BOOST_ASSERT( pool_);
+		pool_->lower_bound( lwm);
+	}
+
+	template< typename Fn >
+	task< typename result_of< Fn() >::result_type > submit( Fn fn)
+	{
+        BOOST_ASSERT( pool_);
+		return pool_->submit( fn);
+	}
+
+	template< typename Fn >
+	task< typename result_of< Fn() >::result_type > submit( BOOST_RV_REF( Fn) fn)
+	{
+        BOOST_ASSERT( pool_);
+		return pool_->submit( boost::move( fn) );
+	}
+
+	template< typename Fn >
+	task< typename result_of< Fn() >::result_type > submit( Fn fn, affinity const& hint)
+	{
+        BOOST_ASSERT( pool_);
+		return pool_->submit( fn, hint);
+	}
+
+	template< typename Fn >
+	task< typename result_of< Fn() >::result_type > submit( BOOST_RV_REF( Fn) fn, affinity const& hint)
+	{
+        BOOST_ASSERT( pool_);
+		return pool_->submit( boost::move( fn), hint);
+	}
+
+	template< typename Fn, typename Attr >
+	task< typename result_of< Fn() >::result_type > submit( Fn fn, Attr const& attr)
+	{
+        BOOST_ASSERT( pool_);
+		return pool_->submit( fn, attr);
+	}
+
+	template< typename Fn, typename Attr >
+	task< typename result_of< Fn() >::result_type > submit( BOOST_RV_REF( Fn) fn, Attr const& attr)
+	{
+        BOOST_ASSERT( pool_);
+		return pool_->submit( boost::move( fn), attr);
+	}
+};
+
+template< typename Queue, typename Policy >
+void swap( tasks::basic_pool< Queue, Policy > & l, tasks::basic_pool< Queue, Policy > & r)
+{ return l.swap( r); }
+
+}}
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_SUFFIX
+#endif
+
+#endif // BOOST_TASKS_BASIC_POOL_H
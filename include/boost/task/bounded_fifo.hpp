@@ -7,6 +7,7 @@
 #ifndef BOOST_TASKS_BOUNDED_FIFO_H
 #define BOOST_TASKS_BOUNDED_FIFO_H
 
+#include <algorithm>
 #include <cstddef>
 
 #include <boost/assert.hpp>
@@ -215,6 +216,23 @@ public:
 		if ( fsem_) fsem_->post();
 	}
 
+	// never blocks - returns false if the high watermark is reached
+	// or the queue is not active
+	bool try_put( value_type const& va)
+	{
+		node::ptr_type new_node( new node);
+		{
+			unique_lock< mutex > lk( tail_mtx_);
+			if ( ! active_() || full_() ) return false;
+			tail_->va = va;
+			tail_->next = new_node;
+			tail_ = new_node;
+			count_.fetch_add( 1);
+		}
+		if ( fsem_) fsem_->post();
+		return true;
+	}
+
 	bool try_take( value_type & va)
 	{
 		unique_lock< mutex > lk( head_mtx_);
@@ -234,6 +252,27 @@ public:
 		return valid;
 	}
 
+	// takes up to n items, but not more than the share of one of
+	// parts consumers, with one lock acquisition
+	std::size_t try_take_n( value_type * va, std::size_t n, std::size_t parts)
+	{
+		unique_lock< mutex > lk( head_mtx_);
+		// items counted are linked - count_ is incremented after
+		std::size_t size( size_() );
+		n = ( std::min)( n, ( std::min)( size, ( std::max)( std::size_t( 1), size / parts) ) );
+		std::size_t i = 0;
+		while ( 0 < n--)
+		{
+			va[i].swap( head_->va);
+			pop_head_();
+			if ( ! va[i].empty() ) ++i;
+		}
+		if ( 0 < i && size_() <= lwm_)
+			// more than one producer could be waiting
+			not_full_cond_.notify_all();
+		return i;
+	}
+
     friend
     inline void intrusive_ptr_add_ref( bounded_fifo_base< T > * p)
     { p->use_count_.fetch_add( 1, memory_order_relaxed); }
@@ -345,11 +384,23 @@ public:
         impl_->put( va, rel_time);
 	}
 
+	bool try_put( value_type const& va)
+	{
+        BOOST_ASSERT( impl_);
+        return impl_->try_put( va);
+	}
+
 	bool try_take( value_type & va)
 	{
         BOOST_ASSERT( impl_);
 		return impl_->try_take( va);
 	}
+
+	std::size_t try_take_n( value_type * va, std::size_t n, std::size_t parts = 1)
+	{
+        BOOST_ASSERT( impl_);
+		return impl_->try_take_n( va, n, parts);
+	}
 };
 
 template< typename T >
@@ -167,6 +167,21 @@ private:
 		return true;
 	}
 
+	std::size_t try_take_n_( T * t, std::size_t n, std::size_t parts)
+	{
+		std::size_t size( size_() );
+		n = ( std::min)( n, ( std::min)( size, ( std::max)( std::size_t( 1), size / parts) ) );
+		for ( std::size_t i = 0; i < n; ++i)
+		{
+			t[i] = queue_.top().t;
+			queue_.pop();
+		}
+		if ( 0 < n && size_() <= lwm_)
+			// more than one producer could be waiting
+			not_full_cond_.notify_all();
+		return n;
+	}
+
 	bool producers_activate_() const
 	{ return ! active_() || ! full_(); }
 
@@ -250,6 +265,30 @@ public:
 		unique_lock< shared_mutex > lk( mtx_);
 		return try_take_( t);
 	}
+
+	// takes the item with the highest priority only if its attribute
+	// is at or above min_attr
+	bool try_take( T & t, attribute_type const& min_attr)
+	{
+		unique_lock< shared_mutex > lk( mtx_);
+		if ( empty_() || Comp()( queue_.top().attr, min_attr) ) return false;
+		return try_take_( t);
+	}
+
+	// true if no item at or above min_attr is queued
+	bool empty( attribute_type const& min_attr) const
+	{
+		shared_lock< shared_mutex > lk( mtx_);
+		return empty_() || Comp()( queue_.top().attr, min_attr);
+	}
+
+	// takes up to n items in priority order, but not more than the
+	// share of one of parts consumers, with one lock acquisition
+	std::size_t try_take_n( T * t, std::size_t n, std::size_t parts)
+	{
+		unique_lock< shared_mutex > lk( mtx_);
+		return try_take_n_( t, n, parts);
+	}
 };
 
 }
@@ -271,6 +310,7 @@ private:
 public:
 	typedef typename detail::bounded_prio_queue_base< T, Attr, Comp >::attribute_tag_type	attribute_tag_type;
 	typedef typename detail::bounded_prio_queue_base< T, Attr, Comp >::value_type			value_type;
+	typedef Attr	attribute_type;
     typedef void ( * unspecified_bool_type)( bounded_prio_queue< T, Attr, Comp > ***);
 
     static void unspecified_bool( bounded_prio_queue< T, Attr, Comp > ***) {}
@@ -361,6 +401,28 @@ public:
 		BOOST_ASSERT( impl_);
 		return impl_->try_take( t);
 	}
+
+	bool try_take( T & t, attribute_type const& min_attr)
+	{
+		BOOST_ASSERT( impl_);
+		return impl_->try_take( t, min_attr);
+	}
+
+	bool empty( attribute_type const& min_attr) const
+	{
+		BOOST_ASSERT( impl_);
+		return impl_->empty( min_attr);
+	}
+
+	// true if attr is at or above min_attr
+	static bool at_least( attribute_type const& attr, attribute_type const& min_attr)
+	{ return ! Comp()( attr, min_attr); }
+
+	std::size_t try_take_n( T * t, std::size_t n, std::size_t parts = 1)
+	{
+		BOOST_ASSERT( impl_);
+		return impl_->try_take_n( t, n, parts);
+	}
 };
 
 template< typename T, typename Attr, typename Comp >
@@ -29,18 +29,49 @@ namespace boost {
 namespace tasks {
 namespace detail {
 
+class callable_token;
+
 struct BOOST_TASK_DECL callable_base
 {
+	// references of the callables - queued or executing
 	atomic< unsigned int >	use_count;
+	// references of the tasks waiting for the result plus one for
+	// all callables - they do not keep the promise alive
+	atomic< unsigned int >	weak_count;
+	// set by the first one executing the callable - a worker-thread
+	// or a thread waiting for the result
+	atomic< bool >			claimed;
 
 	callable_base() :
-		use_count( 0)
+		use_count( 0), weak_count( 1), claimed( false)
 	{}
 
 	virtual ~callable_base() {}
 
+	bool claim()
+	{
+		bool expected( false);
+		return claimed.compare_exchange_strong(
+			expected, true, memory_order_acq_rel, memory_order_relaxed);
+	}
+
+	// takes a reference unless the last callable was dropped
+	bool lock()
+	{
+		unsigned int n( use_count.load( memory_order_relaxed) );
+		while ( 0 != n)
+			if ( use_count.compare_exchange_weak(
+					n, n + 1, memory_order_acquire, memory_order_relaxed) )
+				return true;
+		return false;
+	}
+
 	virtual void run() = 0;
 
+	// breaks the promise - the callable was dropped without being
+	// executed (a queue drained at shutdown)
+	virtual void abandon() = 0;
+
 	virtual void reset( shared_ptr< thread > const&) = 0;
 
 	inline friend void intrusive_ptr_add_ref( callable_base * p)
@@ -49,6 +80,19 @@ struct BOOST_TASK_DECL callable_base
 	inline friend void intrusive_ptr_release( callable_base * p)
 	{
 		if ( p->use_count.fetch_sub( 1, memory_order_release) == 1)
+		{
+			atomic_thread_fence( memory_order_acquire);
+			if ( p->claim() ) p->abandon();
+			weak_release( p);
+		}
+	}
+
+	inline friend void weak_add_ref( callable_base * p)
+	{ p->weak_count.fetch_add( 1, memory_order_relaxed); }
+
+	inline friend void weak_release( callable_base * p)
+	{
+		if ( p->weak_count.fetch_sub( 1, memory_order_release) == 1)
 		{
 			atomic_thread_fence( memory_order_acquire);
 			delete p;
@@ -103,6 +147,11 @@ public:
         ctx_( ctx)
 	{}
 
+	// the promise is moved out and destroyed, the future becomes
+	// ready with broken_promise
+	void abandon()
+	{ Promise tmp( boost::move( prom_) ); }
+
 	void reset( shared_ptr< thread > const& thrd)
 	{ ctx_.reset( thrd); }
 };
@@ -112,11 +161,16 @@ public:
 class BOOST_TASK_DECL callable
 {
 private:
+	friend class detail::callable_token;
+
 	intrusive_ptr< detail::callable_base >	base_;
 
 public:
 	callable();
 
+	// takes over a reference passed out by release()
+	explicit callable( detail::callable_base *);
+
 	template< typename Fn, typename Promise >
 	callable( Fn fn,
 			  BOOST_RV_REF( Promise) prom,
@@ -133,15 +187,57 @@ public:
                 boost::move( fn), boost::move( prom), ctx) )
 	{}
 
+	// executes the callable if it was not claimed before
 	void operator()();
 
+	// claims and executes the callable, returns false if it
+	// was already claimed
+	bool try_run();
+
+	bool claimed() const;
+
 	bool empty() const;
 
 	void reset( shared_ptr< thread > const&);
 
 	void swap( callable &);
+
+	// passes the reference out, the callable is empty afterwards
+	detail::callable_base * release();
 };
 
+namespace detail {
+
+// refers to a callable without keeping its promise alive - held by the
+// task waiting for the result, so that a task dropped from a queue
+// delivers broken_promise instead of blocking the waiter
+class BOOST_TASK_DECL callable_token
+{
+private:
+	callable_base	*	base_;
+
+public:
+	callable_token();
+
+	explicit callable_token( callable const&);
+
+	callable_token( callable_token const&);
+
+	~callable_token();
+
+	callable_token & operator=( callable_token const&);
+
+	// claims and executes the callable if it is still queued, returns
+	// false if it was claimed or dropped before
+	bool try_run();
+
+	bool empty() const;
+
+	void swap( callable_token &);
+};
+
+}
+
 }}
 
 #ifdef BOOST_HAS_ABI_HEADERS
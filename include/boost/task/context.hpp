@@ -75,9 +75,15 @@ class BOOST_TASK_DECL context
 private:
 	detail::context_base::ptr_t     base_;
 
+	context( detail::context_base::ptr_t const&);
+
 public:
 	context();
 
+	// context of a pool without interruption support - no allocation,
+	// interrupt() has no effect
+	static context none();
+
 	void reset( shared_ptr< thread > const& thrd);
 
 	void interrupt();
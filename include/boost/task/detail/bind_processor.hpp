@@ -0,0 +1,46 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_TASKS_DETAIL_BIND_PROCESSOR_H
+#define BOOST_TASKS_DETAIL_BIND_PROCESSOR_H
+
+#include <vector>
+
+#include <boost/config.hpp>
+
+#include <boost/task/detail/config.hpp>
+
+#if defined(__linux__)
+# define BOOST_HAS_PROCESSOR_BINDINGS
+#endif
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_PREFIX
+#endif
+
+#if defined(BOOST_HAS_PROCESSOR_BINDINGS)
+
+namespace boost {
+namespace tasks {
+namespace detail {
+
+// CPUs the calling thread may run on (the full sched_getaffinity mask,
+// not limited to CPU_SETSIZE)
+BOOST_TASK_DECL std::vector< int > allowed_processors();
+
+// binds the calling thread to the CPU - returns false if the CPU is not
+// in the affinity mask of the process
+BOOST_TASK_DECL bool bind_to_processor( int);
+
+}}}
+
+#endif
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_SUFFIX
+#endif
+
+#endif // BOOST_TASKS_DETAIL_BIND_PROCESSOR_H
@@ -0,0 +1,38 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_TASKS_DETAIL_CLOCK_H
+#define BOOST_TASKS_DETAIL_CLOCK_H
+
+#include <boost/cstdint.hpp>
+
+#include <boost/task/detail/config.hpp>
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_PREFIX
+#endif
+
+namespace boost {
+namespace tasks {
+namespace detail {
+
+// microseconds since an unspecified point in time - the clock does not
+// follow adjustments of the system time, so intervals are never negative
+// (CLOCK_MONOTONIC, QueryPerformanceCounter)
+BOOST_TASK_DECL boost::int64_t monotonic_now();
+
+// microseconds of CPU time consumed by the calling thread - the clock
+// stands still while the thread is preempted or blocked
+// (CLOCK_THREAD_CPUTIME_ID, GetThreadTimes)
+BOOST_TASK_DECL boost::int64_t thread_cpu_now();
+
+}}}
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_SUFFIX
+#endif
+
+#endif // BOOST_TASKS_DETAIL_CLOCK_H
@@ -31,6 +31,26 @@
 # define BOOST_TASK_DECL
 #endif
 
+// native thread-local storage - exported TLS variables are not
+// supported by MSVC, the DLL falls back to an out-of-line accessor
+#if defined(__GNUC__) || defined(__SUNPRO_CC) || defined(__IBMCPP__)
+# define BOOST_TASK_TLS __thread
+#elif defined(BOOST_MSVC) && ! defined(BOOST_DYN_LINK)
+# define BOOST_TASK_TLS __declspec(thread)
+#endif
+
+// tells the processor that the thread busy-waits
+#if defined(__GNUC__) && ( defined(__i386__) || defined(__x86_64__) )
+# define BOOST_TASK_CPU_RELAX() __builtin_ia32_pause()
+#elif defined(__GNUC__) && defined(__aarch64__)
+# define BOOST_TASK_CPU_RELAX() __asm__ __volatile__( "yield" ::: "memory")
+#elif defined(BOOST_MSVC) && ( defined(_M_IX86) || defined(_M_X64) )
+# include <intrin.h>
+# define BOOST_TASK_CPU_RELAX() _mm_pause()
+#else
+# define BOOST_TASK_CPU_RELAX()
+#endif
+
 #if ! defined(BOOST_TASK_SOURCE) && ! defined(BOOST_ALL_NO_LIB) && ! defined(BOOST_TASK_NO_LIB)
 # define BOOST_LIB_NAME boost_task
 # if defined(BOOST_ALL_DYN_LINK) || defined(BOOST_TASK_DYN_LINK)
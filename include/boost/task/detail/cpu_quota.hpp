@@ -0,0 +1,56 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_TASKS_DETAIL_CPU_QUOTA_H
+#define BOOST_TASKS_DETAIL_CPU_QUOTA_H
+
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+
+#include <boost/task/detail/config.hpp>
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_PREFIX
+#endif
+
+namespace boost {
+namespace tasks {
+namespace detail {
+
+// CPU time per period the process may use, in CPUs, as limited by the
+// CFS quota of its cgroup (cgroup v2 cpu.max or cgroup v1
+// cpu.cfs_quota_us) and of the parent cgroups - 0 if unlimited or
+// not supported
+BOOST_TASK_DECL double cpu_quota();
+
+// number of CPUs the process may run on (affinity mask)
+BOOST_TASK_DECL std::size_t cpu_affinity();
+
+// the parsers used by cpu_quota()
+
+// directory of the cgroup of the process, from the contents of
+// /proc/self/mountinfo and /proc/self/cgroup - v2: unified hierarchy,
+// v1: hierarchy of the cpu controller
+BOOST_TASK_DECL bool cgroup_dir(
+	bool v2, std::istream & mountinfo, std::istream & cgroup,
+	std::string & dir, std::string & mount_point);
+
+// quota in CPUs of a cgroup v2 cpu.max line ("<quota> <period>" or
+// "max <period>"), 0 if unlimited or malformed
+BOOST_TASK_DECL double cpu_max_quota( std::string const&);
+
+// quota in CPUs of cgroup v1 cpu.cfs_quota_us and cpu.cfs_period_us
+// (the quota is -1 if unlimited), 0 if unlimited or malformed
+BOOST_TASK_DECL double cfs_quota( std::string const&, std::string const&);
+
+}}}
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_SUFFIX
+#endif
+
+#endif // BOOST_TASKS_DETAIL_CPU_QUOTA_H
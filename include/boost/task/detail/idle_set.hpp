@@ -0,0 +1,89 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_TASKS_DETAIL_IDLE_SET_H
+#define BOOST_TASKS_DETAIL_IDLE_SET_H
+
+#include <cstddef>
+
+#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/scoped_array.hpp>
+#include <boost/utility.hpp>
+
+#include <boost/task/detail/config.hpp>
+
+# if defined(BOOST_MSVC)
+# pragma warning(push)
+# pragma warning(disable:4251 4275)
+# endif
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_PREFIX
+#endif
+
+namespace boost {
+namespace tasks {
+namespace detail {
+
+// bitmap of parked worker-threads (indexed by the worker index)
+// and the number of worker-threads searching for work
+//
+// a producer makes its work visible and calls notify():
+//  - if a worker-thread is searching, it will find the work - the last
+//    searcher re-checks the queues when it stops and wakes one up if
+//    work was queued behind its scan
+//  - otherwise one parked worker-thread is claimed and woken up
+// a worker-thread announces itself in the bitmap before it re-checks
+// the queues a last time and parks, so no wake-up gets lost
+class BOOST_TASK_DECL idle_set : private noncopyable
+{
+private:
+	typedef boost::uint64_t	word_t;
+
+	static const std::size_t	bits = 64;
+
+	std::size_t						size_;
+	std::size_t						words_;
+	scoped_array< atomic< word_t > >	mask_;
+	atomic< std::size_t >			hint_;
+	atomic< unsigned int >			searching_;
+
+public:
+	idle_set( std::size_t);
+
+	// mark worker as parked
+	void add( std::size_t);
+
+	// remove worker from the parked set - returns false if
+	// another thread has already claimed (and will unpark) it
+	bool remove( std::size_t);
+
+	// claim one parked worker
+	bool claim( std::size_t &);
+
+	bool empty() const;
+
+	// only one worker-thread searches (steals) at a time
+	bool begin_search();
+
+	// returns true if the caller was the last searching worker-thread
+	bool end_search();
+
+	unsigned int searching() const;
+};
+
+}}}
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_SUFFIX
+#endif
+
+# if defined(BOOST_MSVC)
+# pragma warning(pop)
+# endif
+
+#endif // BOOST_TASKS_DETAIL_IDLE_SET_H
@@ -0,0 +1,89 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_TASKS_DETAIL_INBOX_H
+#define BOOST_TASKS_DETAIL_INBOX_H
+
+#include <cstddef>
+#include <deque>
+
+#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/utility.hpp>
+
+#include <boost/task/callable.hpp>
+#include <boost/task/detail/config.hpp>
+
+# if defined(BOOST_MSVC)
+# pragma warning(push)
+# pragma warning(disable:4251 4275)
+# endif
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_PREFIX
+#endif
+
+namespace boost {
+namespace tasks {
+namespace detail {
+
+// tasks submitted to a particular worker-thread
+// the owner takes them in FIFO order, other worker-threads may steal
+// a task only if it was posted before a given time
+class BOOST_TASK_DECL inbox : private noncopyable
+{
+private:
+	struct entry
+	{
+		callable		ca;
+		boost::int64_t	stamp;
+
+		entry( callable const& ca_, boost::int64_t stamp_) :
+			ca( ca_), stamp( stamp_)
+		{}
+	};
+
+	typedef std::deque< entry >	queue_t;
+
+	mutable mutex			mtx_;
+	queue_t					queue_;
+	// stamp of the oldest task, -1 if the inbox is empty
+	atomic< boost::int64_t >	oldest_;
+	bool					active_;
+
+	void take_( callable &);
+
+public:
+	inbox();
+
+	bool empty() const;
+
+	// time at which the oldest task was posted, -1 if empty
+	boost::int64_t oldest() const;
+
+	// returns true if the inbox was empty
+	bool put( callable const&, boost::int64_t);
+
+	bool try_take( callable &);
+
+	bool try_steal( callable &, boost::int64_t);
+
+	// further tasks are rejected, the queued ones are still taken
+	void deactivate();
+};
+
+}}}
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_SUFFIX
+#endif
+
+# if defined(BOOST_MSVC)
+# pragma warning(pop)
+# endif
+
+#endif // BOOST_TASKS_DETAIL_INBOX_H
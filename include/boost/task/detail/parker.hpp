@@ -0,0 +1,78 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_TASKS_DETAIL_PARKER_H
+#define BOOST_TASKS_DETAIL_PARKER_H
+
+#include <boost/atomic.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/utility.hpp>
+
+#if ! defined(__linux__)
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#endif
+
+#include <boost/task/detail/config.hpp>
+
+# if defined(BOOST_MSVC)
+# pragma warning(push)
+# pragma warning(disable:4251 4275)
+# endif
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_PREFIX
+#endif
+
+namespace boost {
+namespace tasks {
+namespace detail {
+
+// parks exactly one thread (the owner)
+// unpark() stores a token if the owner is not parked, so that
+// the next park() returns immediately - no system call is made
+// if the owner is not parked
+// on Linux the owner sleeps on a futex
+class BOOST_TASK_DECL parker : private noncopyable
+{
+private:
+	enum state
+	{
+		PARKED = -1,
+		EMPTY = 0,
+		NOTIFIED = 1
+	};
+
+	atomic< int >			state_;
+#if ! defined(__linux__)
+	mutex					mtx_;
+	condition_variable		cond_;
+#endif
+
+public:
+	parker();
+
+	void park();
+
+	// returns false if the timeout elapsed without a token - the
+	// timeout is measured on the monotonic clock, adjustments of the
+	// system time do not shorten or extend it
+	bool park_for( posix_time::time_duration const&);
+
+	void unpark();
+};
+
+}}}
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_SUFFIX
+#endif
+
+# if defined(BOOST_MSVC)
+# pragma warning(pop)
+# endif
+
+#endif // BOOST_TASKS_DETAIL_PARKER_H
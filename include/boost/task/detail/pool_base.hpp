@@ -8,31 +8,48 @@
 #define BOOST_TASKS_DETAIL_POOL_BASE_H
 
 #include <cstddef>
+#include <limits>
+#include <vector>
 
 #include <boost/assert.hpp>
 #include <boost/atomic.hpp>
 #include <boost/bind.hpp>
 #include <boost/config.hpp>
+#include <boost/cstdint.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/intrusive_ptr.hpp>
 #include <boost/shared_ptr.hpp>
 #include <boost/thread.hpp>
 #include <boost/thread/detail/move.hpp>
 #include <boost/thread/future.hpp>
 
+#include <boost/task/affinity.hpp>
 #include <boost/task/callable.hpp>
 #include <boost/task/context.hpp>
 #include <boost/task/detail/bind_processor.hpp>
+#include <boost/task/detail/clock.hpp>
+#include <boost/task/detail/cpu_quota.hpp>
+#include <boost/task/detail/idle_set.hpp>
+#include <boost/task/detail/stack_cache.hpp>
 #include <boost/task/detail/worker_group.hpp>
 #include <boost/task/detail/worker.hpp>
 #include <boost/task/exceptions.hpp>
-#include <boost/task/fast_semaphore.hpp>
+#include <boost/task/fairness_tick.hpp>
 #include <boost/task/handle.hpp>
+#include <boost/task/idle_strategy.hpp>
+#include <boost/task/latency_lanes.hpp>
+#include <boost/task/pool_policy.hpp>
 #include <boost/task/poolsize.hpp>
+#include <boost/task/processor_set.hpp>
+#include <boost/task/sharded_fifo.hpp>
 #include <boost/task/spin/future.hpp>
 #include <boost/task/stacksize.hpp>
+#include <boost/task/statistics.hpp>
+#include <boost/task/steal_batch.hpp>
 #include <boost/task/task.hpp>
 #include <boost/task/utility.hpp>
 #include <boost/task/watermark.hpp>
+#include <boost/task/worker_capacity.hpp>
 
 #ifdef BOOST_HAS_ABI_HEADERS
 #  include BOOST_ABI_PREFIX
@@ -42,15 +59,88 @@ namespace boost {
 namespace tasks {
 namespace detail {
 
-template< typename Queue >
+// the sizing of a pool - the constructors of the pools differ only
+// in it and in the watermarks of a bounded queue
+struct pool_settings
+{
+	// worker-threads started with the pool
+	std::size_t					size;
+	// slots of the worker-group, the maximum pool size
+	std::size_t					capacity;
+	// worker-threads running tasks, the others stand by
+	std::size_t					active;
+	bool						resizable;
+	// the CPU quota is tracked
+	bool						automatic;
+	// CPUs the worker-threads are bound to, empty if not bound
+	std::vector< int >			cpus;
+	posix_time::time_duration	keep_alive;
+	posix_time::time_duration	max_latency;
+
+	// an automatic pool contains one worker-thread per CPU of the
+	// affinity mask, the CPU quota decides how many of them run tasks
+	explicit pool_settings( poolsize const& psize) :
+		size( psize.is_automatic()
+			? ( std::max)( static_cast< std::size_t >( psize), cpu_affinity() )
+			: static_cast< std::size_t >( psize) ),
+		capacity( size),
+		active( psize),
+		resizable( false),
+		automatic( psize.is_automatic() ),
+		cpus(),
+		keep_alive( posix_time::pos_infin),
+		max_latency( posix_time::pos_infin)
+	{}
+
+#if defined(BOOST_HAS_PROCESSOR_BINDINGS)
+	explicit pool_settings( processor_set const& cpus_) :
+		size( cpus_.size() ),
+		capacity( cpus_.size() ),
+		active( cpus_.size() ),
+		resizable( false),
+		automatic( false),
+		cpus(),
+		keep_alive( posix_time::pos_infin),
+		max_latency( posix_time::pos_infin)
+	{
+		for ( std::size_t i = 0; i < cpus_.size(); ++i)
+			cpus.push_back( cpus_[i]);
+	}
+#endif
+
+	pool_settings(
+			poolsize const& min_size,
+			poolsize const& max_size,
+			posix_time::time_duration const& keep_alive_,
+			posix_time::time_duration const& max_latency_) :
+		size( min_size),
+		capacity( max_size),
+		active( max_size),
+		resizable( true),
+		automatic( false),
+		cpus(),
+		keep_alive( keep_alive_),
+		max_latency( max_latency_)
+	{
+		if ( min_size > max_size)
+			throw invalid_pool_bounds();
+	}
+};
+
+template< typename Queue, typename Policy = default_pool_policy >
 class pool_base
 {
 private:
-	template< typename T, typename Z >
+	template< typename Pool >
 	friend class worker_object;
 
 	typedef Queue							queue_type;
 	typedef typename queue_type::value_type	value_type;
+	typedef Policy							policy_type;
+
+	// microseconds a task submitted with an affinity hint waits for the
+	// chosen worker-thread before other worker-threads may steal it
+	static const boost::int64_t	affinity_delay = 1000;
 
 	enum state
 	{
@@ -58,26 +148,434 @@ private:
 		DEACTIVE	
 	};
 
-	atomic< unsigned int >	use_count_;
-	fast_semaphore			fsem_;
-	worker_group			wg_;
-	shared_mutex			mtx_wg_;
-	atomic< state >			state_;
-	queue_type				queue_;
-	atomic< bool >			shtdwn_;
-	atomic< bool >			shtdwn_now_;
+	atomic< unsigned int >		use_count_;
+	idle_set					idle_;
+	// parked lane worker-threads
+	idle_set					lanes_idle_;
+	bool						resizable_;
+	std::size_t					min_size_;
+	posix_time::time_duration	keep_alive_;
+	posix_time::time_duration	max_latency_;
+	stack_pool					stacks_;
+	// CPUs the worker-threads are bound to, empty if not bound
+	std::vector< int >			cpus_;
+	worker_group				wg_;
+	mutable shared_mutex		mtx_wg_;
+	// worker-threads with a higher index stand by (CPU quota)
+	atomic< std::size_t >		active_;
+	tasks::statistics			retired_stats_;
+	atomic< state >				state_;
+	queue_type					queue_;
+	atomic< std::size_t >		pending_;
+	// tasks waiting in the inboxes of the worker-threads
+	atomic< std::size_t >		posted_;
+	atomic< boost::int64_t >	last_take_;
+	atomic< bool >				shtdwn_;
+	atomic< bool >				shtdwn_now_;
+	atomic< std::size_t >		steal_batch_;
+	atomic< std::size_t >		local_capacity_;
+	atomic< std::size_t >		tick_executions_;
+	atomic< boost::int64_t >	tick_interval_;
+	atomic< int >				idle_mode_;
+	atomic< boost::int64_t >	idle_window_;
+	atomic< bool >				topology_aware_;
+	atomic< bool >				lazy_fibers_;
+	atomic< bool >				help_while_waiting_;
+	atomic< bool >				local_submission_;
+	// worker-threads below lanes_ run only tasks at or above the
+	// threshold (an attribute_type)
+	atomic< std::size_t >		lanes_;
+	shared_ptr< void const >	lane_threshold_;
+	thread						supervisor_;
 
-	void create_worker_(
-		poolsize const& psize,
-		stacksize const& stack_size)
-	{ wg_.add( worker::create( * this, psize) ); }
+	// monotonic microseconds - read at each fairness-tick check, so
+	// it must be cheap and must not step backward
+	static boost::int64_t now_()
+	{ return monotonic_now(); }
 
 	std::size_t size_() const
 	{ return wg_.size(); }
 
+	// without interruption support a task gets no context
+	static context context_()
+	{ return policy_type::interruption ? context() : context::none(); }
+
 	bool deactivated_() const
 	{ return DEACTIVE == state_.load(); }
 
+	// wakes up at most one parked worker-thread, no system call
+	// is made if a worker-thread is searching or none is parked
+	void notify_()
+	{
+		atomic_thread_fence( memory_order_seq_cst);
+		if ( 0 < idle_.searching() ) return;
+		std::size_t idx;
+		if ( idle_.claim( idx) ) wg_[idx]->unpark();
+	}
+
+	void notify_all_()
+	{
+		std::size_t idx;
+		while ( idle_.claim( idx) ) wg_[idx]->unpark();
+		while ( lanes_idle_.claim( idx) ) wg_[idx]->unpark();
+	}
+
+	// a task at or above the lane threshold wakes up a parked lane
+	// worker-thread, other tasks a general one
+	template< typename T >
+	void notify_( T const&, detail::has_no_attribute)
+	{ notify_(); }
+
+	template< typename T >
+	void notify_( T const& va, detail::has_attribute)
+	{
+		typedef typename queue_type::attribute_type	attribute_type;
+		if ( 0 < lanes_.load( memory_order_relaxed) )
+		{
+			shared_ptr< attribute_type const > threshold(
+				static_pointer_cast< attribute_type const >( atomic_load( & lane_threshold_) ) );
+			if ( threshold && queue_type::at_least( va.attr, * threshold) )
+			{
+				atomic_thread_fence( memory_order_seq_cst);
+				std::size_t idx;
+				if ( lanes_idle_.claim( idx) )
+				{
+					wg_[idx]->unpark();
+					return;
+				}
+			}
+		}
+		notify_();
+	}
+
+	bool lane_( std::size_t idx) const
+	{ return idx < lanes_.load( memory_order_relaxed); }
+
+	// takes a task at or above the lane threshold
+	bool take_lane_( callable & ca)
+	{ return take_lane_( ca, typename queue_type::attribute_tag_type() ); }
+
+	bool take_lane_( callable &, detail::has_no_attribute)
+	{ return false; }
+
+	bool take_lane_( callable & ca, detail::has_attribute)
+	{
+		typedef typename queue_type::attribute_type	attribute_type;
+		shared_ptr< attribute_type const > threshold(
+			static_pointer_cast< attribute_type const >( atomic_load( & lane_threshold_) ) );
+		return threshold && queue_.try_take( ca, * threshold);
+	}
+
+	bool has_lane_work_() const
+	{ return has_lane_work_( typename queue_type::attribute_tag_type() ); }
+
+	bool has_lane_work_( detail::has_no_attribute) const
+	{ return false; }
+
+	bool has_lane_work_( detail::has_attribute) const
+	{
+		typedef typename queue_type::attribute_type	attribute_type;
+		shared_ptr< attribute_type const > threshold(
+			static_pointer_cast< attribute_type const >( atomic_load( & lane_threshold_) ) );
+		return threshold && ! queue_.empty( * threshold);
+	}
+
+	// called by the worker-thread with index reader - without stealing
+	// the worker-queues of the other worker-threads are not its work
+	bool has_work_( std::size_t reader) const
+	{
+		if ( ! queue_.empty() ) return true;
+		if ( ! policy_type::stealing) return false;
+		worker_registry::reader wg( wg_.registry(), reader, resizable_);
+		for ( std::size_t i = 0; i < wg->size(); ++i)
+		{
+			worker * w( ( * wg)[i]);
+			if ( w && ! w->empty() ) return true;
+		}
+		return false;
+	}
+
+	template< typename T >
+	void put_( T const& va)
+	{
+		if ( resizable_) pending_.fetch_add( 1, memory_order_relaxed);
+		queue_.put( va);
+		notify_( va, typename queue_type::attribute_tag_type() );
+		if ( resizable_ && overloaded_() ) grow_();
+	}
+
+	// the task is queued in the inbox of the chosen worker-thread which
+	// is woken up if parked - if it is busy, one parked worker-thread is
+	// woken up so that it can steal the task after affinity_delay
+	void post_( std::size_t hint, callable const& ca)
+	{
+		// a worker-thread retires only with an empty inbox
+		shared_lock< shared_mutex > lk( mtx_wg_, defer_lock);
+		if ( resizable_) lk.lock();
+
+		// standby worker-threads are skipped
+		std::size_t size( ( std::min)( wg_.capacity(), active_.load( memory_order_relaxed) ) );
+		std::size_t idx( hint % size);
+		for ( std::size_t j = 0; j < size; ++j, ++idx)
+		{
+			if ( idx >= size) idx = 0;
+			worker * w( wg_[idx]);
+			if ( ! w) continue;
+			posted_.fetch_add( 1, memory_order_relaxed);
+			bool first( false);
+			try
+			{ first = w->post( ca, now_() ); }
+			catch (...)
+			{
+				posted_.fetch_sub( 1, memory_order_relaxed);
+				throw;
+			}
+			atomic_thread_fence( memory_order_seq_cst);
+			if ( idle_.remove( idx) ) w->unpark();
+			else if ( first) notify_();
+			return;
+		}
+		BOOST_ASSERT( false && "no worker-thread running");
+	}
+
+	// time at which the oldest task in an inbox may be stolen,
+	// -1 if all inboxes are empty
+	// called by the worker-thread with index reader
+	boost::int64_t posted_due_( std::size_t reader) const
+	{
+		// parking worker-threads do not scan the inboxes if
+		// nothing was posted
+		if ( 0 == posted_.load( memory_order_relaxed) ) return -1;
+
+		worker_registry::reader wg( wg_.registry(), reader, resizable_);
+
+		boost::int64_t oldest( -1);
+		for ( std::size_t i = 0; i < wg->size(); ++i)
+		{
+			worker * w( ( * wg)[i]);
+			if ( ! w) continue;
+			boost::int64_t posted( w->posted() );
+			if ( -1 != posted && ( -1 == oldest || posted < oldest) )
+				oldest = posted;
+		}
+		return -1 == oldest ? -1 : oldest + affinity_delay;
+	}
+
+	// called by a worker-thread which took a task from an inbox
+	void posted_taken_()
+	{ posted_.fetch_sub( 1, memory_order_relaxed); }
+
+	void close_inboxes_()
+	{
+		shared_lock< shared_mutex > lk( mtx_wg_);
+		for ( std::size_t i = 0; i < wg_.capacity(); ++i)
+		{
+			worker * w( wg_[i]);
+			if ( w) w->close();
+		}
+	}
+
+	// the tasks left behind by shutdown_now() are dropped - their
+	// promises are broken, so that threads waiting for them do not
+	// block until the pool is destroyed; the worker-threads are joined
+	// but still in their slots
+	void discard_()
+	{
+		while ( ! queue_.empty() )
+		{
+			callable ca;
+			queue_.try_take( ca);
+		}
+		wg_.discard_all();
+	}
+
+	// the joined worker-threads leave their slots - their counters are
+	// kept, so that statistics() reports them after shutdown
+	// caller must hold mtx_wg_ exclusively
+	void clear_()
+	{
+		for ( std::size_t i = 0; i < wg_.capacity(); ++i)
+		{
+			worker * w( wg_[i]);
+			if ( w) w->add_statistics( retired_stats_);
+		}
+		wg_.clear();
+	}
+
+	// the worker-queue of a worker-thread is full - the task goes to the
+	// global queue if it accepts the task without blocking
+	bool spill_( callable const& ca)
+	{ return spill_( ca, typename queue_type::attribute_tag_type() ); }
+
+	bool spill_( callable const& ca, detail::has_no_attribute)
+	{
+		if ( resizable_) pending_.fetch_add( 1, memory_order_relaxed);
+		if ( ! queue_.try_put( ca) )
+		{
+			if ( resizable_) pending_.fetch_sub( 1, memory_order_relaxed);
+			return false;
+		}
+		notify_();
+		return true;
+	}
+
+	// a priority queue requires an attribute
+	bool spill_( callable const&, detail::has_attribute)
+	{ return false; }
+
+	// a task submitted by a worker-thread of this pool is pushed to the
+	// worker-queue of the worker-thread - no lock, LIFO execution
+	bool put_local_( callable const& ca)
+	{
+		if ( ! local_submission_.load( memory_order_relaxed) ) return false;
+		worker * w( worker::instance() );
+		if ( ! w || ! w->owned_by( this) ) return false;
+		w->put( ca);
+		return true;
+	}
+
+	// called by a worker-thread which dequeued from the global queue
+	void taken_( std::size_t n = 1)
+	{
+		if ( ! resizable_) return;
+		pending_.fetch_sub( n, memory_order_relaxed);
+		last_take_.store( now_(), memory_order_relaxed);
+	}
+
+	// no worker-thread is idle and either more tasks are queued than
+	// worker-threads are running or the global queue was not served
+	// for longer than max_latency
+	bool overloaded_() const
+	{
+		if ( ! idle_.empty() || 0 < idle_.searching() ) return false;
+		std::size_t pending( pending_.load( memory_order_relaxed) );
+		if ( 0 == pending) return false;
+		if ( pending > wg_.size() ) return true;
+		return now_() - last_take_.load( memory_order_relaxed) >
+			max_latency_.total_microseconds();
+	}
+
+	void grow_()
+	{
+		// another thread is already resizing the worker-group
+		unique_lock< shared_mutex > lk( mtx_wg_, try_to_lock);
+		if ( ! lk || deactivated_() || wg_.size() >= wg_.capacity() ) return;
+		wg_.add( * this);
+	}
+
+	// joins retired worker-threads and frees the slot arrays and
+	// worker-threads no longer read - otherwise they are kept until the
+	// pool grows again
+	void reclaim_()
+	{
+		unique_lock< shared_mutex > lk( mtx_wg_, try_to_lock);
+		if ( ! lk || deactivated_() ) return;
+		wg_.join_retired();
+	}
+
+	// grows the pool if the worker-threads block in their tasks
+	// and no further tasks are submitted
+	void supervise_()
+	{
+		try
+		{
+			while ( ! deactivated_() )
+			{
+				this_thread::sleep( max_latency_);
+				if ( overloaded_() ) grow_();
+				reclaim_();
+			}
+		}
+		catch ( thread_interrupted const&)
+		{}
+	}
+
+	// a sharded queue gets one shard per worker-thread - worker-thread
+	// i owns shard i, the default count of the queue does not know the
+	// pool size
+	template< typename Q >
+	static void shard_queue_( Q &, std::size_t)
+	{}
+
+	template< typename T >
+	static void shard_queue_( sharded_fifo< T > & q, std::size_t size)
+	{
+		sharded_fifo< T > tmp( size);
+		q.swap( tmp);
+	}
+
+	// a resizable pool is supervised, an automatic one tracks the
+	// CPU quota
+	void start_( pool_settings const& ps)
+	{
+		BOOST_ASSERT( ps.resizable == policy_type::resizable);
+		shard_queue_( queue_, wg_.capacity() );
+		wg_.start_all();
+		if ( ps.resizable)
+			supervisor_ = thread( bind( & pool_base::supervise_, this) );
+		else if ( ps.automatic)
+			supervisor_ = thread( bind( & pool_base::track_quota_, this) );
+	}
+
+	// worker-threads with an index below n run tasks, the others
+	// stand by - a standby worker-thread is woken up when activated
+	// worker-threads put on standby leave the parked set, so that
+	// notify_() does not spend a wake-up on them; a worker-thread
+	// claimed meanwhile passes its wake-up on (see worker_object)
+	void activate_( std::size_t n)
+	{
+		n = ( std::min)( n, wg_.capacity() );
+		std::size_t prev( active_.exchange( n) );
+		for ( std::size_t i = n; i < prev; ++i)
+		{
+			worker * w( wg_[i]);
+			if ( w && idle_.remove( i) ) w->unpark();
+		}
+		for ( std::size_t i = prev; i < n; ++i)
+		{
+			worker * w( wg_[i]);
+			if ( w) w->unpark();
+		}
+	}
+
+	// re-evaluates the CPU quota of an automatic pool once per second
+	void track_quota_()
+	{
+		try
+		{
+			while ( ! deactivated_() )
+			{
+				this_thread::sleep( posix_time::seconds( 1) );
+				activate_( poolsize::automatic() );
+			}
+		}
+		catch ( thread_interrupted const&)
+		{}
+	}
+
+	void stop_supervisor_()
+	{
+		if ( ! supervisor_.joinable() ) return;
+		supervisor_.interrupt();
+		supervisor_.join();
+	}
+
+	// called by a worker-thread which was idle for keep_alive
+	// the worker-thread must terminate if true is returned
+	bool retire_( std::size_t idx)
+	{
+		// shutdown() holds the lock while it joins the worker-threads
+		unique_lock< shared_mutex > lk( mtx_wg_, try_to_lock);
+		if ( ! lk || deactivated_() || wg_.size() <= min_size_) return false;
+		// tasks were posted to the worker-thread
+		if ( -1 != wg_[idx]->posted() ) return false;
+		// a claimed worker-thread has a wake-up pending
+		if ( ! idle_.remove( idx) ) return false;
+		wg_[idx]->add_statistics( retired_stats_);
+		wg_.retire( idx);
+		return true;
+	}
+
 	bool deactivate_()
 	{ return ACTIVE == state_.exchange( DEACTIVE); }
 
@@ -94,33 +592,85 @@ private:
     }
 
 public:
+	typedef intrusive_ptr< pool_base >	ptr_t;
+
 	pool_base(
-			poolsize const& psize,
+			pool_settings const& ps,
 			stacksize const& stack_size) :
 		use_count_( 0),
-		fsem_( 0),
-		wg_( * this, psize),
+		idle_( ps.capacity),
+		lanes_idle_( ps.capacity),
+		resizable_( ps.resizable),
+		min_size_( ps.size),
+		keep_alive_( ps.keep_alive),
+		max_latency_( ps.max_latency),
+		stacks_( stack_size, ps.capacity),
+		cpus_( ps.cpus),
+		wg_( * this, ps.size, ps.capacity),
 		mtx_wg_(),
+		active_( ps.active),
+		retired_stats_(),
 		state_( ACTIVE),
-		queue_( fsem_),
+		queue_(),
+		pending_( 0),
+		posted_( 0),
+		last_take_( ps.resizable ? now_() : 0),
 		shtdwn_( false),
-		shtdwn_now_( false)
-	{ wg_.start_all();	}
+		shtdwn_now_( false),
+		steal_batch_( 1),
+		local_capacity_( ( std::numeric_limits< std::size_t >::max)() ),
+		tick_executions_( 61),
+		tick_interval_( 1000),
+		idle_mode_( idle_strategy::park),
+		idle_window_( 50),
+		topology_aware_( true),
+		lazy_fibers_( false),
+		help_while_waiting_( true),
+		local_submission_( true),
+		lanes_( 0),
+		lane_threshold_(),
+		supervisor_()
+	{ start_( ps); }
 
 	pool_base(
-			poolsize const& psize,
+			pool_settings const& ps,
 			high_watermark const& hwm,
 			low_watermark const& lwm,
 			stacksize const& stack_size) :
 		use_count_( 0),
-		fsem_( 0),
-		wg_( * this, psize),
+		idle_( ps.capacity),
+		lanes_idle_( ps.capacity),
+		resizable_( ps.resizable),
+		min_size_( ps.size),
+		keep_alive_( ps.keep_alive),
+		max_latency_( ps.max_latency),
+		stacks_( stack_size, ps.capacity),
+		cpus_( ps.cpus),
+		wg_( * this, ps.size, ps.capacity),
 		mtx_wg_(),
+		active_( ps.active),
+		retired_stats_(),
 		state_( ACTIVE),
-		queue_( fsem_, hwm, lwm),
+		queue_( hwm, lwm),
+		pending_( 0),
+		posted_( 0),
+		last_take_( ps.resizable ? now_() : 0),
 		shtdwn_( false),
-		shtdwn_now_( false)
-	{ wg_.start_all();	}
+		shtdwn_now_( false),
+		steal_batch_( 1),
+		local_capacity_( ( std::numeric_limits< std::size_t >::max)() ),
+		tick_executions_( 61),
+		tick_interval_( 1000),
+		idle_mode_( idle_strategy::park),
+		idle_window_( 50),
+		topology_aware_( true),
+		lazy_fibers_( false),
+		help_while_waiting_( true),
+		local_submission_( true),
+		lanes_( 0),
+		lane_threshold_(),
+		supervisor_()
+	{ start_( ps); }
 
 	~pool_base()
 	{ shutdown(); }
@@ -138,10 +688,23 @@ public:
 		if ( deactivated_() || ! deactivate_() ) return;
 
 		queue_.deactivate();
-		fsem_.deactivate();
-		shared_lock< shared_mutex > lk( mtx_wg_);
+		close_inboxes_();
+		stop_supervisor_();
+		activate_( wg_.capacity() );
 		shtdwn_.store( true);
-		wg_.join_all();
+		notify_all_();
+		// the worker-threads are joined under the shared lock - a
+		// worker-thread of a resizable pool takes it to post a task and
+		// would block forever behind an exclusive lock
+		// the slots are emptied afterwards under the exclusive lock, so
+		// that statistics(), size() and the other readers never see a
+		// half-emptied worker-group
+		{
+			shared_lock< shared_mutex > lk( mtx_wg_);
+			wg_.join_all();
+		}
+		unique_lock< shared_mutex > lk( mtx_wg_);
+		clear_();
 	}
 
 	void shutdown_now()
@@ -149,11 +712,20 @@ public:
 		if ( deactivated_() || ! deactivate_() ) return;
 
 		queue_.deactivate();
-		fsem_.deactivate();
-		shared_lock< shared_mutex > lk( mtx_wg_);
+		close_inboxes_();
+		stop_supervisor_();
+		activate_( wg_.capacity() );
 		shtdwn_now_.store( true);
-		wg_.interrupt_all();
-		wg_.join_all();
+		notify_all_();
+		// see shutdown()
+		{
+			shared_lock< shared_mutex > lk( mtx_wg_);
+			wg_.interrupt_all();
+			wg_.join_all();
+		}
+		unique_lock< shared_mutex > lk( mtx_wg_);
+		discard_();
+		clear_();
 	}
 
 	std::size_t size() const
@@ -177,6 +749,115 @@ public:
 	void lower_bound( low_watermark const lwm)
 	{ queue_.lower_bound( lwm); }
 
+	std::size_t steal_batch_size() const
+	{ return steal_batch_.load(); }
+
+	void steal_batch_size( steal_batch const& sb)
+	{ steal_batch_.store( sb); }
+
+	std::size_t worker_queue_capacity() const
+	{ return local_capacity_.load(); }
+
+	void worker_queue_capacity( worker_capacity const& wc)
+	{ local_capacity_.store( wc); }
+
+	std::size_t stack_cache_size() const
+	{ return stacks_.cache_limit(); }
+
+	void stack_cache_size( std::size_t n)
+	{ stacks_.cache_limit( n); }
+
+	fairness_tick fairness() const
+	{
+		return fairness_tick(
+			tick_executions_.load(),
+			posix_time::microseconds( tick_interval_.load() ) );
+	}
+
+	void fairness( fairness_tick const& ft)
+	{
+		tick_executions_.store( ft.executions() );
+		tick_interval_.store( ft.interval().total_microseconds() );
+	}
+
+	tasks::idle_strategy idle() const
+	{
+		return tasks::idle_strategy(
+			static_cast< idle_strategy::mode >( idle_mode_.load() ),
+			posix_time::microseconds( idle_window_.load() ) );
+	}
+
+	void idle( tasks::idle_strategy const& is)
+	{
+		idle_window_.store( is.window().total_microseconds() );
+		idle_mode_.store( is.get_mode() );
+	}
+
+	bool topology_aware() const
+	{ return topology_aware_.load(); }
+
+	void topology_aware( bool value)
+	{ topology_aware_.store( value); }
+
+	bool lazy_fibers() const
+	{ return lazy_fibers_.load(); }
+
+	void lazy_fibers( bool value)
+	{ lazy_fibers_.store( value); }
+
+	bool help_while_waiting() const
+	{ return help_while_waiting_.load(); }
+
+	void help_while_waiting( bool value)
+	{ help_while_waiting_.store( value); }
+
+	bool local_submission() const
+	{ return local_submission_.load(); }
+
+	void local_submission( bool value)
+	{ local_submission_.store( value); }
+
+	std::size_t lanes() const
+	{ return lanes_.load(); }
+
+	// worker-threads 0 .. workers - 1 become lane worker-threads
+	template< typename Attr >
+	void lanes( latency_lanes< Attr > const& ll)
+	{
+		typedef typename queue_type::attribute_type	attribute_type;
+		if ( ll.workers() >= size_() ) throw invalid_latency_lanes();
+		atomic_store(
+			& lane_threshold_,
+			shared_ptr< void const >( new attribute_type( ll.threshold() ) ) );
+		std::size_t prev( lanes_.exchange( ll.workers() ) );
+		// parked worker-threads which change their role are woken up
+		// and park again in their new role
+		std::size_t idx;
+		for ( idx = ll.workers(); idx < prev; ++idx)
+			if ( lanes_idle_.remove( idx) ) wg_[idx]->unpark();
+		for ( idx = 0; idx < ll.workers(); ++idx)
+			if ( idle_.remove( idx) ) wg_[idx]->unpark();
+	}
+
+	std::size_t min_size() const
+	{ return min_size_; }
+
+	std::size_t max_size() const
+	{ return wg_.capacity(); }
+
+	tasks::statistics statistics() const
+	{
+		shared_lock< shared_mutex > lk( mtx_wg_);
+		tasks::statistics st( retired_stats_);
+		for ( std::size_t i = 0; i < wg_.capacity(); ++i)
+		{
+			worker * w( wg_[i]);
+			if ( w) w->add_statistics( st);
+		}
+		st.stacks_mapped = stacks_.mapped();
+		return st;
+	}
+
 	template< typename Fn >
 	task< typename result_of< Fn() >::result_type > submit( Fn fn)
 	{
@@ -189,18 +870,20 @@ public:
 		{
 			detail::promise< R > prom;
 			detail::shared_future< R > f( prom.get_future() );
-			context ctx;
-			task< R > t( f, ctx);
-			queue_.put( callable( fn, boost::move( prom), ctx) );
+			context ctx( context_() );
+			callable ca( fn, boost::move( prom), ctx);
+			task< R > t( f, ctx, ca);
+			if ( ! put_local_( ca) ) put_( ca);
 			return t;
 		}
 		else
 		{
 			promise< R > prom;
 			shared_future< R > f( prom.get_future() );
-			context ctx;
-			task< R > t( f, ctx);
-			queue_.put( callable( fn, boost::move( prom), ctx) );
+			context ctx( context_() );
+			callable ca( fn, boost::move( prom), ctx);
+			task< R > t( f, ctx, ca);
+			put_( ca);
 			return t;
 		}
 	}
@@ -217,18 +900,82 @@ public:
 		{
 			detail::promise< R > prom;
 			detail::shared_future< R > f( prom.get_future() );
-			context ctx;
-			task< R > t( f, ctx);
-			queue_.put( callable( boost::move( fn), boost::move( prom), ctx) );
+			context ctx( context_() );
+			callable ca( boost::move( fn), boost::move( prom), ctx);
+			task< R > t( f, ctx, ca);
+			if ( ! put_local_( ca) ) put_( ca);
+			return t;
+		}
+		else
+		{
+			promise< R > prom;
+			shared_future< R > f( prom.get_future() );
+			context ctx( context_() );
+			callable ca( boost::move( fn), boost::move( prom), ctx);
+			task< R > t( f, ctx, ca);
+			put_( ca);
+			return t;
+		}
+	}
+
+	// the task is executed by the worker-thread selected by the hint
+	// unless it is busy for longer than affinity_delay
+	template< typename Fn >
+	task< typename result_of< Fn() >::result_type > submit( Fn fn, affinity const& hint)
+	{
+        typedef typename result_of< Fn() >::result_type R;
+
+		if ( deactivated_() )
+			throw task_rejected("pool is closed");
+
+		if ( this_task::runs_in_pool() )
+		{
+			detail::promise< R > prom;
+			detail::shared_future< R > f( prom.get_future() );
+			context ctx( context_() );
+			callable ca( fn, boost::move( prom), ctx);
+			task< R > t( f, ctx, ca);
+			post_( hint, ca);
 			return t;
 		}
 		else
 		{
 			promise< R > prom;
 			shared_future< R > f( prom.get_future() );
-			context ctx;
-			task< R > t( f, ctx);
-			queue_.put( callable( boost::move( fn), boost::move( prom), ctx) );
+			context ctx( context_() );
+			callable ca( fn, boost::move( prom), ctx);
+			task< R > t( f, ctx, ca);
+			post_( hint, ca);
+			return t;
+		}
+	}
+
+	template< typename Fn >
+	task< typename result_of< Fn() >::result_type > submit( BOOST_RV_REF( Fn) fn, affinity const& hint)
+	{
+        typedef typename result_of< Fn() >::result_type R;
+
+		if ( deactivated_() )
+			throw task_rejected("pool is closed");
+
+		if ( this_task::runs_in_pool() )
+		{
+			detail::promise< R > prom;
+			detail::shared_future< R > f( prom.get_future() );
+			context ctx( context_() );
+			callable ca( boost::move( fn), boost::move( prom), ctx);
+			task< R > t( f, ctx, ca);
+			post_( hint, ca);
+			return t;
+		}
+		else
+		{
+			promise< R > prom;
+			shared_future< R > f( prom.get_future() );
+			context ctx( context_() );
+			callable ca( boost::move( fn), boost::move( prom), ctx);
+			task< R > t( f, ctx, ca);
+			post_( hint, ca);
 			return t;
 		}
 	}
@@ -236,6 +983,8 @@ public:
 	template< typename Fn, typename Attr >
 	task< typename result_of< Fn() >::result_type > submit( Fn fn, Attr const& attr)
 	{
+        typedef typename result_of< Fn() >::result_type R;
+
 		if ( deactivated_() )
 			throw task_rejected("pool is closed");
 
@@ -243,24 +992,20 @@ public:
 		{
 			detail::promise< R > prom;
 			detail::shared_future< R > f( prom.get_future() );
-			context ctx;
-			task< R > t( f, ctx);
-			queue_.put(
-				value_type(
-					callable( fn, boost::move( prom), ctx),
-					attr) );
+			context ctx( context_() );
+			callable ca( fn, boost::move( prom), ctx);
+			task< R > t( f, ctx, ca);
+			put_( value_type( ca, attr) );
 			return t;
 		}
 		else
 		{
 			promise< R > prom;
 			shared_future< R > f( prom.get_future() );
-			context ctx;
-			task< R > t( f, ctx);
-			queue_.put(
-				value_type(
-					callable( fn, boost::move( prom), ctx),
-					attr) );
+			context ctx( context_() );
+			callable ca( fn, boost::move( prom), ctx);
+			task< R > t( f, ctx, ca);
+			put_( value_type( ca, attr) );
 			return t;
 		}
 	}
@@ -268,6 +1013,8 @@ public:
 	template< typename Fn, typename Attr >
 	task< typename result_of< Fn() >::result_type > submit( BOOST_RV_REF( Fn) fn, Attr const& attr)
 	{
+        typedef typename result_of< Fn() >::result_type R;
+
 		if ( deactivated_() )
 			throw task_rejected("pool is closed");
 
@@ -275,24 +1022,20 @@ public:
 		{
 			detail::promise< R > prom;
 			detail::shared_future< R > f( prom.get_future() );
-			context ctx;
-			task< R > t( f, ctx);
-			queue_.put(
-				value_type(
-					callable( boost::move( fn), boost::move( prom), ctx),
-					attr) );
+			context ctx( context_() );
+			callable ca( boost::move( fn), boost::move( prom), ctx);
+			task< R > t( f, ctx, ca);
+			put_( value_type( ca, attr) );
 			return t;
 		}
 		else
 		{
 			promise< R > prom;
 			shared_future< R > f( prom.get_future() );
-			context ctx;
-			task< R > t( f, ctx);
-			queue_.put(
-				value_type(
-					callable( boost::move( fn), boost::move( prom), ctx),
-					attr) );
+			context ctx( context_() );
+			callable ca( boost::move( fn), boost::move( prom), ctx);
+			task< R > t( f, ctx, ca);
+			put_( value_type( ca, attr) );
 			return t;
 		}
 	}
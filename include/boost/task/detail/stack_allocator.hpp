@@ -0,0 +1,69 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_TASKS_DETAIL_STACK_ALLOCATOR_H
+#define BOOST_TASKS_DETAIL_STACK_ALLOCATOR_H
+
+#include <cstddef>
+
+#include <boost/task/detail/config.hpp>
+
+# if defined(BOOST_MSVC)
+# pragma warning(push)
+# pragma warning(disable:4251 4275)
+# endif
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_PREFIX
+#endif
+
+namespace boost {
+namespace tasks {
+namespace detail {
+
+// stack of a fiber - sp points to the top of the stack (stacks grow
+// downwards), size is the usable size without the guard page
+struct stack
+{
+	void		*	sp;
+	std::size_t		size;
+
+	stack() :
+		sp( 0), size( 0)
+	{}
+
+	stack( void * sp_, std::size_t size_) :
+		sp( sp_), size( size_)
+	{}
+};
+
+// maps stacks directly from the operating system - the page below
+// each stack is protected, so that a stack overflow faults instead
+// of overwriting other memory
+class BOOST_TASK_DECL stack_allocator
+{
+public:
+	static std::size_t pagesize();
+
+	// size rounded up to whole pages
+	static std::size_t round( std::size_t);
+
+	static stack allocate( std::size_t);
+
+	static void deallocate( stack const&);
+};
+
+}}}
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_SUFFIX
+#endif
+
+# if defined(BOOST_MSVC)
+# pragma warning(pop)
+# endif
+
+#endif // BOOST_TASKS_DETAIL_STACK_ALLOCATOR_H
@@ -0,0 +1,97 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_TASKS_DETAIL_STACK_CACHE_H
+#define BOOST_TASKS_DETAIL_STACK_CACHE_H
+
+#include <cstddef>
+#include <vector>
+
+#include <boost/atomic.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/utility.hpp>
+
+#include <boost/task/detail/config.hpp>
+#include <boost/task/detail/stack_allocator.hpp>
+
+# if defined(BOOST_MSVC)
+# pragma warning(push)
+# pragma warning(disable:4251 4275)
+# endif
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_PREFIX
+#endif
+
+namespace boost {
+namespace tasks {
+namespace detail {
+
+// unused stacks of one pool - the stack caches of the worker-threads
+// overflow into it; at most cache_limit() stacks per worker-thread are
+// kept, further stacks are unmapped
+class BOOST_TASK_DECL stack_pool : private noncopyable
+{
+public:
+	static const std::size_t	default_cache_limit = 16;
+
+private:
+	std::size_t				size_;
+	std::size_t				workers_;
+	atomic< std::size_t >	cache_limit_;
+	mutex					mtx_;
+	std::vector< stack >	stacks_;
+	atomic< std::size_t >	mapped_;
+
+public:
+	stack_pool( std::size_t, std::size_t);
+
+	~stack_pool();
+
+	std::size_t stacksize() const;
+
+	// number of unused stacks a worker-thread keeps in its cache
+	std::size_t cache_limit() const;
+
+	void cache_limit( std::size_t);
+
+	// number of stacks mapped from the operating system so far
+	std::size_t mapped() const;
+
+	stack allocate();
+
+	void deallocate( stack const&);
+};
+
+// unused stacks of one worker-thread - no synchronization as long
+// as the cache is neither empty nor full
+class BOOST_TASK_DECL stack_cache : private noncopyable
+{
+private:
+	stack_pool			&	pool_;
+	std::vector< stack >	stacks_;
+
+public:
+	explicit stack_cache( stack_pool &);
+
+	~stack_cache();
+
+	stack allocate();
+
+	void deallocate( stack const&);
+};
+
+}}}
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_SUFFIX
+#endif
+
+# if defined(BOOST_MSVC)
+# pragma warning(pop)
+# endif
+
+#endif // BOOST_TASKS_DETAIL_STACK_CACHE_H
@@ -0,0 +1,123 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+//  based on 'Non-intrusive MPSC node-based queue' (Vyukov)
+
+#ifndef BOOST_TASKS_DETAIL_STRAND_QUEUE_H
+#define BOOST_TASKS_DETAIL_STRAND_QUEUE_H
+
+#include <cstddef>
+
+#include <boost/atomic.hpp>
+#include <boost/scoped_array.hpp>
+#include <boost/utility.hpp>
+
+#include <boost/task/callable.hpp>
+#include <boost/task/detail/config.hpp>
+
+# if defined(BOOST_MSVC)
+# pragma warning(push)
+# pragma warning(disable:4251 4275)
+# endif
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_PREFIX
+#endif
+
+namespace boost {
+namespace tasks {
+namespace detail {
+
+// tasks of one strand - any thread pushes with one atomic exchange,
+// the task draining the strand pops without synchronization
+// pending_ counts the pushed tasks which were not executed yet - the
+// push which finds the strand empty has to schedule run()
+class BOOST_TASK_DECL strand_queue : private noncopyable
+{
+private:
+	struct node
+	{
+		atomic< node * >	next;
+		callable			ca;
+
+		node() :
+			next( 0), ca()
+		{}
+
+		node( callable const& ca_) :
+			next( 0), ca( ca_)
+		{}
+	};
+
+	atomic< node * >		head_;
+	node				*	tail_;
+	node					stub_;
+	atomic< std::size_t >	pending_;
+
+	void push_( node *);
+
+	node * pop_();
+
+public:
+	strand_queue();
+
+	~strand_queue();
+
+	// returns true if the strand was idle - the caller has to
+	// schedule run()
+	bool push( callable const&);
+
+	// executes at most max tasks in FIFO order - returns true if
+	// tasks are left and run() has to be scheduled again
+	bool run( std::size_t max);
+
+	// drops the queued tasks, their promises are broken - called
+	// instead of run() if the strand could not be scheduled
+	void discard();
+};
+
+// strands addressed by index, shared by the handles and the
+// tasks draining them
+class BOOST_TASK_DECL strand_array : private noncopyable
+{
+private:
+	atomic< std::size_t >			use_count_;
+	std::size_t						size_;
+	scoped_array< strand_queue >	queues_;
+
+	friend inline void intrusive_ptr_add_ref( strand_array * p)
+	{ p->use_count_.fetch_add( 1, memory_order_relaxed); }
+
+	friend inline void intrusive_ptr_release( strand_array * p)
+	{
+		if ( 1 == p->use_count_.fetch_sub( 1, memory_order_release) )
+		{
+			atomic_thread_fence( memory_order_acquire);
+			delete p;
+		}
+	}
+
+public:
+	strand_array( std::size_t);
+
+	std::size_t size() const
+	{ return size_; }
+
+	strand_queue & operator[]( std::size_t idx)
+	{ return queues_[idx]; }
+};
+
+}}}
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_SUFFIX
+#endif
+
+# if defined(BOOST_MSVC)
+# pragma warning(pop)
+# endif
+
+#endif // BOOST_TASKS_DETAIL_STRAND_QUEUE_H
@@ -22,8 +22,21 @@ namespace boost {
 namespace tasks {
 namespace detail {
 
+// state of a task a worker-thread can wait for without knowing its result type
+struct waitable
+{
+    virtual ~waitable() {}
+
+    virtual bool is_ready() const = 0;
+
+    // executes the task on the calling thread if no worker-thread
+    // has started it yet
+    virtual bool try_run() = 0;
+};
+
 template< typename R >
-struct task_base : private noncopyable
+struct task_base : public waitable,
+				   private noncopyable
 {
     typedef intrusive_ptr< task_base >  ptr_t;
 
@@ -43,8 +56,6 @@ struct task_base : private noncopyable
 
     virtual R get() const = 0;
 
-    virtual bool is_ready() const = 0;
-
     virtual bool has_value() const = 0;
 
     virtual bool has_exception() const = 0;
@@ -12,6 +12,7 @@
 #include <boost/move/move.hpp>
 #include <boost/thread/thread_time.hpp>
 
+#include <boost/task/callable.hpp>
 #include <boost/task/context.hpp>
 #include <boost/task/detail/tas_base.hpp>
 
@@ -27,13 +28,16 @@ template< typename R, typename F >
 class task_object : public task_base
 {
 private:
-	F           fut_;
-	context     ctx_;
+	F               fut_;
+	context         ctx_;
+	// does not keep the promise alive - a task dropped from a
+	// queue breaks it
+	callable_token  ca_;
 
 public:
-	task_object( F const& fut, context const& ctx) :
+	task_object( F const& fut, context const& ctx, callable const& ca) :
         task_base< R >(),
-		fut_( boost::move( fut) ), ctx_( ctx)
+		fut_( boost::move( fut) ), ctx_( ctx), ca_( ca)
 	{}
 
 	bool interruption_requested() const
@@ -54,6 +58,16 @@ public:
     bool is_ready() const
     { return fut_.is_ready(); }
 
+    // the reference to the callable is dropped after the first
+    // attempt - it is either executed here or by a worker-thread
+    bool try_run()
+    {
+        if ( ca_.empty() ) return false;
+        callable_token ca;
+        ca.swap( ca_);
+        return ca.try_run();
+    }
+
     bool has_value() const = 0;
     { return fut_.has_value(); }
 
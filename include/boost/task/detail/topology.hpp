@@ -0,0 +1,83 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_TASKS_DETAIL_TOPOLOGY_H
+#define BOOST_TASKS_DETAIL_TOPOLOGY_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <boost/utility.hpp>
+
+#include <boost/task/detail/config.hpp>
+
+# if defined(BOOST_MSVC)
+# pragma warning(push)
+# pragma warning(disable:4251 4275)
+# endif
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_PREFIX
+#endif
+
+namespace boost {
+namespace tasks {
+namespace detail {
+
+// CPU, cache and NUMA topology of the machine
+// on Linux read from /sys, on other systems no topology information
+// is available and all CPUs are considered to be remote
+class BOOST_TASK_DECL topology : private noncopyable
+{
+public:
+	// distance between two CPUs, ordered from near to far - remote
+	// if one of the CPUs is unknown
+	enum level
+	{
+		smt = 0,		// same core
+		cache,			// same last-level cache
+		node,			// same NUMA node
+		remote,			// different NUMA node
+		levels
+	};
+
+	static topology const& instance();
+
+	static int current_cpu();
+
+	static std::vector< int > parse_cpu_list( std::string const&);
+
+	std::size_t cpus() const;
+
+	level distance( int, int) const;
+
+	// lowest CPU of the core the CPU belongs to, the CPU itself if
+	// the topology is unknown
+	int core( int) const;
+
+private:
+	// per CPU the lowest CPU sharing the same core, LLC and node
+	std::vector< int >	core_;
+	std::vector< int >	llc_;
+	std::vector< int >	node_;
+
+	topology();
+
+	static void init_();
+};
+
+}}}
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_SUFFIX
+#endif
+
+# if defined(BOOST_MSVC)
+# pragma warning(pop)
+# endif
+
+#endif // BOOST_TASKS_DETAIL_TOPOLOGY_H
@@ -7,13 +7,17 @@
 #ifndef BOOST_TASKS_DETAIL_WORK_H
 #define BOOST_TASKS_DETAIL_WORK_H
 
-#include <algortihm>
+#include <algorithm>
 
 #include <boost/config.hpp>
-#include <boost/context/all.hpp>
+#include <boost/context/fcontext.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/exception_ptr.hpp>
 #include <boost/move/move.hpp>
 
 #include <boost/task/callable.hpp>
+#include <boost/task/detail/config.hpp>
+#include <boost/task/detail/stack_cache.hpp>
 
 #ifdef BOOST_HAS_ABI_HEADERS
 #  include BOOST_ABI_PREFIX
@@ -23,33 +27,79 @@ namespace boost {
 namespace tasks {
 namespace detail {
 
-class work
+class work;
+
+// continues the scheduler on another stack if a work-item, which runs
+// on the stack of the scheduler, suspends the first time
+class promoter
 {
+public:
+	virtual ~promoter() {}
+
+	// takes over the suspending work-item, returns the context (and the
+	// argument) of the scheduler continuing on another stack
+	virtual ctx::fcontext_t * promote( work &, intptr_t &) = 0;
+
+	// the promoted work-item completed on the stack of the former scheduler,
+	// the scheduler which resumed it (context) continues
+	virtual void handoff( ctx::fcontext_t const&, exception_ptr const&) = 0;
+};
+
+// a callable executed as fiber - the stack is taken from the stack cache
+// of the worker-thread starting it and returned to the cache of the
+// worker-thread on which it completes
+class BOOST_TASK_DECL work
+{
+public:
+	// passed by a terminating scheduler to the scheduler which continues,
+	// the stack of the terminating scheduler has to be deallocated
+	struct handoff
+	{
+		stack			stk;
+		exception_ptr	except;
+	};
+
+	// the two words of a work-item - the worker-queue stores them in
+	// atomic slots instead of allocating a work-item per push
+	struct raw
+	{
+		callable_base	*	ca;
+		void			*	fib;
+	};
+
 private:
-	ctx::fcontext_t	caller_;
-	ctx::fcontext_t	callee_;
+	// control block of a started work-item, placed at the top of its stack
+	struct fiber;
+
+	callable	ca_;
+	fiber	*	fib_;
 
     BOOST_MOVABLE_BUT_NOT_COPYABLE( work);
 
+	static void entry_( intptr_t);
+
+	void destroy_();
+
 public:
     typedef void ( * unspecified_bool_type)( work ***);
 
     static void unspecified_bool( work ***) {}
 
 	work() :
-		caller_(), callee_()
+		ca_(), fib_( 0)
+	{}
+
+	explicit work( callable const& ca) :
+		ca_( ca), fib_( 0)
 	{}
 
-	//FIXME: make stacksize and -unwinding customizable
-	work( callable const& ca) :
-		ctx_( ca,
-			  contexts::default_stacksize(),
-			  contexts::stack_unwind,
-			  contexts::return_to_caller)
+	// takes over the words passed out by release()
+	explicit work( raw const& r) :
+		ca_( r.ca), fib_( static_cast< fiber * >( r.fib) )
 	{}
 
     work( BOOST_RV_REF( work) other) :
-        ctx_()
+        ca_(), fib_( 0)
     { swap( other); }
 
     work & operator=( BOOST_RV_REF( work) other)
@@ -60,34 +110,59 @@ public:
         return * this;
     }
 
+	// the objects on the stack of a suspended work-item are not unwound
+	~work()
+	{ if ( fib_) destroy_(); }
+
     operator unspecified_bool_type() const
-    { return ctx_ ? unspecified_bool : 0; }
+    { return ! ca_.empty() || fib_ ? unspecified_bool : 0; }
 
     bool operator!() const
-    { return ! ctx_; }
+    { return ca_.empty() && ! fib_; }
 
     void swap( work & other)
     {
-		std::swap( started_, other.started_);
-		ctx_.swap( other.ctx_);
+		ca_.swap( other.ca_);
+		std::swap( fib_, other.fib_);
 	}
 
-	void run()
+	// passes the work-item out as two words, it is empty afterwards
+	raw release()
 	{
-		if ( ! ctx_.is_started() )
-			ctx_.start();
-		else
-			ctx_.resume();	
+		raw r;
+		r.ca = ca_.release();
+		r.fib = fib_;
+		fib_ = 0;
+		return r;
 	}
 
-	void yield()
-	{ ctx_.suspend(); }
+	// starts the work-item on a stack from the cache or resumes it
+	// an exception escaping the callable is rethrown
+	void run( stack_cache &);
+
+	// runs the callable on the calling stack - if it suspends the first
+	// time the scheduler is continued on another stack by the promoter
+	// returns false if the work-item was promoted, the calling stack is
+	// then superseded and has to be handed over to the promoter
+	bool run_inline( promoter &);
+
+	// work-items promoted by run_inline() have to be resumed
+	// by the worker-thread which started them
+	bool is_pinned() const;
+
+	// suspends the work-item, must be called from inside it
+	void yield();
 
 	bool is_started() const
-	{ return ctx_.is_started(); }
+	{ return 0 != fib_; }
+
+	// a work-item not started yet whose callable was executed
+	// by a thread waiting for its result
+	bool is_claimed() const
+	{ return ! fib_ && ! ca_.empty() && ca_.claimed(); }
 
 	bool is_complete() const
-	{ return ctx_.is_complete(); }
+	{ return ca_.empty() && ! fib_; }
 };
 
 inline
@@ -100,4 +175,4 @@ void swap( work & l, work & r)
 #  include BOOST_ABI_SUFFIX
 #endif
 
-#endif // BOOST_TASKS_DETAIL_WOR_H
+#endif // BOOST_TASKS_DETAIL_WORK_H
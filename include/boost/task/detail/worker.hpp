@@ -7,20 +7,39 @@
 #ifndef BOOST_TASKS_DETAIL_WORKER_H
 #define BOOST_TASKS_DETAIL_WORKER_H
 
+#include <algorithm>
 #include <cstddef>
+#include <deque>
+#include <vector>
 
 #include <boost/assert.hpp>
+#include <boost/atomic.hpp>
 #include <boost/bind.hpp>
+#include <boost/context/fcontext.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/exception_ptr.hpp>
 #include <boost/intrusive_ptr.hpp>
 #include <boost/random.hpp>
 #include <boost/thread.hpp>
 #include <boost/utility.hpp>
 
+#include <boost/task/callable.hpp>
+#include <boost/task/detail/bind_processor.hpp>
+#include <boost/task/detail/clock.hpp>
 #include <boost/task/detail/config.hpp>
+#include <boost/task/detail/inbox.hpp>
+#include <boost/task/detail/meta.hpp>
+#include <boost/task/detail/parker.hpp>
+#include <boost/task/detail/stack_cache.hpp>
+#include <boost/task/detail/task_base.hpp>
+#include <boost/task/detail/topology.hpp>
 #include <boost/task/detail/work.hpp>
+#include <boost/task/detail/worker_array.hpp>
 #include <boost/task/detail/wsq.hpp>
+#include <boost/task/idle_strategy.hpp>
 #include <boost/task/poolsize.hpp>
 #include <boost/task/stacksize.hpp>
+#include <boost/task/statistics.hpp>
 
 #ifdef BOOST_HAS_ABI_HEADERS
 #  include BOOST_ABI_PREFIX
@@ -30,33 +49,54 @@ namespace boost {
 namespace tasks {
 namespace detail {
 
+class worker;
+
+// describes the calling thread if it is a worker-thread, all members
+// are null otherwise - a POD so that it lives in native TLS and the
+// checks in this_task and the spin primitives are a single load
+struct worker_descriptor
+{
+	worker		*	self;
+	work		*	active;
+	std::size_t		index;
+};
+
+#if defined(BOOST_TASK_TLS)
+extern BOOST_TASK_TLS worker_descriptor worker_tls;
+
+inline
+worker_descriptor & this_worker()
+{ return worker_tls; }
+#else
+BOOST_TASK_DECL worker_descriptor & this_worker();
+#endif
+
 template< typename Worker >
-void worker_function( typename Worker::ptr_t & worker)
+void worker_function( Worker * worker)
 {	
-	while ( ! worker->shutdown_() )
-	{
-		work w;
-		if ( ! ( worker->try_take_local_work_( w) || 
-			 worker->try_take_global_work_( w) ||
-			 worker->try_steal_other_work_( w) ) )
-		{
-			worker->pool_.fsem_.wait();
-			continue;
-		}
+	worker_descriptor & desc( this_worker() );
+	desc.self = worker;
+	desc.active = 0;
+	desc.index = worker->idx_;
 
-		work & active( * tss_);
-		active = move( w);
-		active.run();
-		w = move( active);
-		if ( ! w.is_complete() ) worker->wsq_.put( w);
+	worker->bind_();
+	worker->schedule_();
+	if ( worker->superseded_)
+	{
+		// the scheduler continues on other stacks - the thread's stack is
+		// parked until the last of them terminates and passes its stack
+		intptr_t vp( worker->supersede_( & worker->native_ctx_, stack() ) );
+		worker->stacks_.deallocate( reinterpret_cast< work::handoff * >( vp)->stk);
 	}
+
+	desc.self = 0;
 }
 
 class worker : private noncopyable
 {
 public:
-	typedef intrusive_ptr_t		ptr_t;
-	typedef thread::id			id;
+	typedef intrusive_ptr< worker >	ptr_t;
+	typedef thread::id				id;
 
 	virtual ~worker() {}
 
@@ -68,33 +108,155 @@ public:
 
 	virtual void interrupt() const = 0;
 
-	virtual bool try_steal( work &) = 0;
+	virtual bool empty() const = 0;
+
+	virtual void put( callable const&) = 0;
 
-    static virtual worker * instance();
+	// queues a task submitted with an affinity hint - returns true
+	// if no other task was waiting in the inbox
+	virtual bool post( callable const&, boost::int64_t) = 0;
+
+	// time at which the oldest waiting task was posted, -1 if none
+	virtual boost::int64_t posted() const = 0;
+
+	virtual void close() = 0;
+
+	// drops the tasks left in the run-next slot, the worker-queue and
+	// the inbox - called after the worker-thread has terminated
+	virtual void discard() = 0;
+
+	// executes the waitable if it was not started yet, otherwise the
+	// work-items of the own worker-queue until the waitable is ready or
+	// the worker-queue is empty - called by a work-item which waits for
+	// another one
+	virtual void help( waitable &) = 0;
+
+	// true if the worker-thread belongs to the given pool
+	bool owned_by( void const* pool) const
+	{ return owner_ == pool; }
+
+	// null if the calling thread is not a worker-thread
+	static worker * instance()
+	{ return this_worker().self; }
+
+	// work-item executed by the calling worker-thread
+	static work * active()
+	{ return this_worker().active; }
+
+	void add_statistics( statistics & st) const
+	{
+		st.steal_attempts += steal_attempts_.load( memory_order_relaxed);
+		st.steals += steals_.load( memory_order_relaxed);
+		st.stolen += stolen_.load( memory_order_relaxed);
+		st.remote_steals += remote_steals_.load( memory_order_relaxed);
+		st.promotions += promotions_.load( memory_order_relaxed);
+		st.helped += helped_.load( memory_order_relaxed);
+		st.global_takes += global_takes_.load( memory_order_relaxed);
+		st.global_taken += global_taken_.load( memory_order_relaxed);
+		st.ticks += ticks_.load( memory_order_relaxed);
+		st.spilled += spilled_.load( memory_order_relaxed);
+		st.inlined += inlined_.load( memory_order_relaxed);
+		st.posted += posted_.load( memory_order_relaxed);
+		st.posted_stolen += posted_stolen_.load( memory_order_relaxed);
+		st.spin_time += spin_time_.load( memory_order_relaxed);
+		st.parks += parks_.load( memory_order_relaxed);
+		st.bind_failures += bind_failures_.load( memory_order_relaxed);
+	}
+
+	// CPU the worker-thread was running on when it looked for work
+	// the last time (-1 if unknown)
+	int cpu() const
+	{ return cpu_.load( memory_order_relaxed); }
+
+	void unpark()
+	{ parker_.unpark(); }
 
 protected:
-	worker() :
+	worker( void const* owner) :
+		owner_( owner),
+		steal_attempts_( 0),
+		steals_( 0),
+		stolen_( 0),
+		remote_steals_( 0),
+		promotions_( 0),
+		helped_( 0),
+		global_takes_( 0),
+		global_taken_( 0),
+		ticks_( 0),
+		spilled_( 0),
+		inlined_( 0),
+		posted_( 0),
+		posted_stolen_( 0),
+		spin_time_( 0),
+		parks_( 0),
+		bind_failures_( 0),
+		cpu_( -1),
+		parker_(),
 		use_count_( 0)
-	{ tss_.reset( new work() ); }
+	{}
+
+	// counters are only written by the owning worker-thread
+	static void count_( atomic< std::size_t > & c, std::size_t n = 1)
+	{ c.store( c.load( memory_order_relaxed) + n, memory_order_relaxed); }
 
-	static thread_specific_ptr< work >	tss_; 
+	void const*				owner_;
+	atomic< std::size_t >	steal_attempts_;
+	atomic< std::size_t >	steals_;
+	atomic< std::size_t >	stolen_;
+	atomic< std::size_t >	remote_steals_;
+	atomic< std::size_t >	promotions_;
+	atomic< std::size_t >	helped_;
+	atomic< std::size_t >	global_takes_;
+	atomic< std::size_t >	global_taken_;
+	atomic< std::size_t >	ticks_;
+	atomic< std::size_t >	spilled_;
+	atomic< std::size_t >	inlined_;
+	atomic< std::size_t >	posted_;
+	atomic< std::size_t >	posted_stolen_;
+	atomic< std::size_t >	spin_time_;
+	atomic< std::size_t >	parks_;
+	atomic< std::size_t >	bind_failures_;
+	atomic< int >			cpu_;
+	parker					parker_;
 
 private:
     friend inline void intrusive_ptr_add_ref( worker * p)
-    { ++p->use_count_; }
+    { p->use_count_.fetch_add( 1, memory_order_relaxed); }
 
     friend inline void intrusive_ptr_release( worker * p)
-    { if ( --p->use_count_ == 0) delete p; }
+    {
+        if ( 1 == p->use_count_.fetch_sub( 1, memory_order_release) )
+        {
+            atomic_thread_fence( memory_order_acquire);
+            delete p;
+        }
+    }
 
-	std::size_t		use_count_;
+	atomic< std::size_t >	use_count_;
 };
 
 template< typename Pool >
-class worker_object : public worker
+class worker_object : public worker,
+					  private promoter
 {
+private:
+	typedef typename Pool::policy_type	policy_type;
+
+	// counters compile away without instrumentation
+	static void count_( atomic< std::size_t > & c, std::size_t n = 1)
+	{ if ( policy_type::instrumentation) worker::count_( c, n); }
+
 public:
-	static ptr_t create( Pool & pool, poolsize const& psize)
-	{ return ptr_t( new worker_object( pool, psize) ); }
+	static ptr_t create( Pool & pool, std::size_t size, std::size_t idx)
+	{ return ptr_t( new worker_object( pool, size, idx) ); }
+
+	~worker_object()
+	{
+		for ( typename pinned_t::iterator i = pinned_.begin(); i != pinned_.end(); ++i)
+			delete * i;
+		work w;
+		try_take_next_work_( w, false);
+	}
 
 	const id get_id() const
 	{ return thrd_.get_id(); }
@@ -103,17 +265,148 @@ public:
 	{ thrd_.join(); }
 
 	void start()
-	{ thrd_ = thread( bind( & worker_function< worker_objecty< Pool > >, this) ); }
+	{ thrd_ = thread( bind( & worker_function< worker_object< Pool > >, this) ); }
 
 	void interrupt() const
 	{ thrd_.interrupt(); }
 
-	bool try_steal( work & w)
-	{ return wsq_.try_steal( w); }
+	bool empty() const
+	{ return wsq_.empty() && ready_.empty() && ! next_.load( memory_order_relaxed); }
+
+	bool post( callable const& ca, boost::int64_t stamp)
+	{ return inbox_.put( ca, stamp); }
+
+	boost::int64_t posted() const
+	{ return inbox_.oldest(); }
+
+	void close()
+	{ inbox_.deactivate(); }
+
+	void discard()
+	{
+		work w;
+		try_take_next_work_( w, false);
+		while ( wsq_.try_take( w) ) {}
+		callable ca;
+		while ( inbox_.try_take( ca) ) pool_.posted_taken_();
+	}
+
+	// the newest work-item goes to the run-next slot, the previous one
+	// is moved to the worker-queue where it can be stolen
+	// a full worker-queue overflows into the global queue - if that does
+	// not accept the task without blocking, the task is executed inline
+	// unless inline_limit tasks are already nested on the stack, then it
+	// goes to the worker-queue regardless of its capacity
+	void put( callable const& ca)
+	{
+		if ( next_.load( memory_order_relaxed) && 0 == room_() )
+		{
+			if ( pool_.spill_( ca) )
+			{
+				count_( spilled_);
+				return;
+			}
+			if ( inline_depth_.load( memory_order_relaxed) < inline_limit)
+			{
+				count_( inlined_);
+				inline_guard g( inline_depth_);
+				callable tmp( ca);
+				tmp();
+				return;
+			}
+		}
+		// the slot can be stolen - an idle worker-thread is woken up
+		// whether it was empty or not
+		callable tmp( ca);
+		work::raw r = { next_.exchange( tmp.release(), memory_order_acq_rel), 0 };
+		if ( r.ca)
+		{
+			work w( r);
+			wsq_.put( boost::move( w) );
+		}
+		pool_.notify_();
+	}
+
+	void help( waitable & t)
+	{
+		// the awaited task is executed by the waiter if no worker-thread
+		// has started it yet - it is taken from whichever queue holds it,
+		// which a pool without stealing does not do
+		if ( policy_type::stealing && t.try_run() ) return;
+		if ( ! pool_.help_while_waiting_.load( memory_order_relaxed) ) return;
+
+		worker_descriptor & desc( this_worker() );
+		work * waiter( desc.active);
+		while ( ! t.is_ready() )
+		{
+			// only the run-next slot and the worker-queue are drained -
+			// they hold the work-items spawned last, the awaited one and
+			// its siblings; the global queue, inboxes and other worker-
+			// queues are left to the scheduler and the searching
+			// worker-thread, their tasks are unrelated to the waiter
+			work w;
+			if ( ! ( try_take_next_work_( w, false) ||
+				 try_take_local_work_( w) ) )
+				return;
+			if ( w.is_claimed() ) continue;
+			count_( helped_);
+
+			// helped work-items always run on their own fiber - they
+			// return to the waiter if they suspend
+			desc.active = & w;
+			try
+			{ w.run( stacks_); }
+			catch ( thread_interrupted const&)
+			{}
+			desc.active = waiter;
+			suspend_( w);
+		}
+	}
 
 private:
     template< typename Worker >
-	friend void worker_function( typename Worker::ptr_t &);
+	friend void worker_function( Worker *);
+
+	typedef std::deque< work * >	pinned_t;
+
+	// consecutive executions from the run-next slot - two work-items
+	// waking each other must not starve the worker-queue
+	static const std::size_t	next_limit = 3;
+	// work-items moved from the global queue at once
+	static const std::size_t	global_batch = 32;
+	// pause instructions between two polls of a spinning worker-thread
+	static const std::size_t	spin_pauses = 64;
+	// polls between two reads of the thread CPU clock - a system call
+	// on most platforms
+	static const std::size_t	spin_checks = 4;
+	// pause instructions before the run-next slots of the other
+	// worker-threads are stolen - once per scan
+	static const std::size_t	next_grace = 256;
+	// tasks executed inline nested on the stack of a spawning task
+	static const std::size_t	inline_limit = 8;
+
+	// an inline task which suspends may complete on another worker-
+	// thread - it releases the depth of the worker-thread it started on
+	class inline_guard
+	{
+	private:
+		atomic< std::size_t >	&	depth_;
+
+	public:
+		inline_guard( atomic< std::size_t > & depth) :
+			depth_( depth)
+		{ depth_.fetch_add( 1, memory_order_relaxed); }
+
+		~inline_guard()
+		{ depth_.fetch_sub( 1, memory_order_relaxed); }
+	};
+
+	// placed at the top of a stack allocated for a scheduler
+	struct scheduler_frame
+	{
+		worker_object	*	self;
+		stack				stk;
+	};
 
 	class random_idx
 	{
@@ -131,38 +424,727 @@ private:
 		{ return die_(); }
 	};
 
-	worker_object( Pool & pool, poolsize const& psize) :
-		worker(),
+	worker_object( Pool & pool, std::size_t size, std::size_t idx) :
+		worker( & pool),
 		pool_( pool),
+		idx_( idx),
 		thrd_(),
-		wsq_( pool_.fsem_),
+		wsq_( pool.wg_.registry() ),
+		ready_( pool.wg_.registry() ),
+		inbox_(),
+		ready_turn_( false),
+		next_( 0),
+		next_runs_( 0),
+		inline_depth_( 0),
+		tick_runs_( 0),
+		last_tick_( 0),
+		tick_source_( 0),
+		spin_window_( 10),
+		stacks_( pool.stacks_),
+		pinned_(),
+		superseded_( false),
+		native_ctx_(),
+		handoff_ctx_(),
+		handoff_except_(),
 		shtdwn_( false),
-		rnd_idx_( psize)
-	{}
+		retired_( false),
+		rnd_idx_( size)
+	{
+		for ( unsigned int level = 0; level < topology::levels; ++level)
+			victims_[level].reserve( size);
+	}
+
+	// a pool constructed with a processor_set binds its worker-threads,
+	// worker-thread i runs on the i-th CPU of the set
+	void bind_()
+	{
+#if defined(BOOST_HAS_PROCESSOR_BINDINGS)
+		if ( pool_.cpus_.empty() ) return;
+		// the CPU left the affinity mask of the process after the
+		// processor set was checked - the worker-thread runs unbound,
+		// counted even without instrumentation
+		if ( ! bind_to_processor( pool_.cpus_[idx_ % pool_.cpus_.size()]) )
+			worker::count_( bind_failures_);
+#endif
+	}
+
+	// batches keep the order of a queue without attributes only - a
+	// batch moved from a priority queue into the worker-queue would run
+	// before tasks of higher priority enqueued afterwards
+	static std::size_t global_batch_( has_no_attribute)
+	{ return global_batch; }
 
+	static std::size_t global_batch_( has_attribute)
+	{ return 1; }
+
+	// moves the share of one worker-thread from the global queue, but
+	// at most global_batch work-items, with one lock acquisition
 	bool try_take_global_work_( work & w)
-	{ return pool_.queue_.try_take( w); }
+	{
+		callable batch[global_batch];
+		std::size_t max(
+			global_batch_( typename Pool::queue_type::attribute_tag_type() ) );
+		// latency lanes require a queue with attributes - a task at or
+		// above the threshold taken by a general worker-thread must not
+		// wait in its worker-queue behind other tasks
+		BOOST_ASSERT( 1 == max || ! pool_.lane_( 0) );
+		std::size_t n(
+			pool_.queue_.try_take_n(
+				batch,
+				( std::min)( max - 1, room_() ) + 1,
+				pool_.wg_.size() ) );
+		if ( 0 == n) return false;
+		pool_.taken_( n);
+		count_( global_takes_);
+		count_( global_taken_, n);
+		// the oldest work-item is executed now, the others are pushed
+		// so that they are taken from the worker-queue in FIFO order
+		for ( std::size_t i = n - 1; 0 < i; --i)
+		{
+			work tmp( batch[i]);
+			wsq_.put( boost::move( tmp) );
+		}
+		work tmp( batch[0]);
+		w = boost::move( tmp);
+		if ( 1 < n) pool_.notify_();
+		return true;
+	}
 
 	bool try_take_local_work_( work & w)
 	{ return wsq_.try_take( w); }
+
+	// tasks submitted to this worker-thread with an affinity hint
+	bool try_take_posted_work_( work & w)
+	{
+		callable ca;
+		if ( ! inbox_.try_take( ca) ) return false;
+		pool_.posted_taken_();
+		count_( posted_);
+		work tmp( ca);
+		w = boost::move( tmp);
+		return true;
+	}
+
+	// free slots of the worker-queue
+	std::size_t room_() const
+	{
+		std::size_t capacity( pool_.local_capacity_.load( memory_order_relaxed) );
+		std::size_t size( wsq_.size() );
+		return capacity > size ? capacity - size : 0;
+	}
+
+	// the run-next slot is taken at most next_limit times in a row if
+	// limited - then the other sources get their turn
+	bool try_take_next_work_( work & w, bool limited)
+	{
+		if ( limited && next_limit <= next_runs_) return false;
+		work::raw r = { next_.exchange( 0, memory_order_acquire), 0 };
+		if ( ! r.ca) return false;
+		work tmp( r);
+		w = boost::move( tmp);
+		return true;
+	}
+
+	// claims the callable ca from the run-next slot of another
+	// worker-thread - fails if the slot does not hold it any more
+	bool try_steal_next_from_( worker_object & other, callable_base * ca, work & w)
+	{
+		count_( steal_attempts_);
+		// the pointer is dereferenced only if the slot still holds it
+		work::raw r = { ca, 0 };
+		if ( ! other.next_.compare_exchange_strong(
+				r.ca, 0, memory_order_acquire, memory_order_relaxed) )
+			return false;
+		r.ca = ca;
+		work tmp( r);
+		w = boost::move( tmp);
+		count_( steals_);
+		count_( stolen_);
+		return true;
+	}
+
+	// suspended work-items are kept apart from the tasks in the
+	// worker-queue - they are resumed in FIFO order
+	void suspend_( work & w)
+	{
+		if ( w.is_complete() ) return;
+		if ( w.is_pinned() )
+			pinned_.push_back( new work( boost::move( w) ) );
+		else
+			ready_.put( boost::move( w) );
+	}
+
+	// the ready-queue is used as FIFO by taking from its public end
+	// pinned and ready work-items take turns
+	bool try_take_ready_work_( work & w)
+	{
+		ready_turn_ = ! ready_turn_;
+		if ( ready_turn_)
+			return ready_.try_steal( w) || try_take_pinned_work_( w);
+		return try_take_pinned_work_( w) || ready_.try_steal( w);
+	}
+
+	bool try_take_pinned_work_( work & w)
+	{
+		if ( pinned_.empty() ) return false;
+		work * p( pinned_.front() );
+		pinned_.pop_front();
+		w = boost::move( * p);
+		delete p;
+		return true;
+	}
+
+	// the local sources are preferred - a fairness-tick is due after
+	// tick_executions_ work-items or if tick_interval_ has elapsed
+	bool tick_due_()
+	{
+		if ( ++tick_runs_ >= pool_.tick_executions_.load( memory_order_relaxed) )
+			return true;
+		return pool_.tick_interval_.load( memory_order_relaxed) <= pool_.now_() - last_tick_;
+	}
+
+	// on a fairness-tick the global queue, the suspended work-items and
+	// the worker-queues of other worker-threads are polled before the
+	// local sources - starting with another one at each tick
+	// the other worker-queues are scanned only as the single searcher,
+	// the scan is skipped while another worker-thread searches
+	bool try_take_tick_work_( work & w)
+	{
+		count_( ticks_);
+		tick_runs_ = 0;
+		last_tick_ = pool_.now_();
+		publish_cpu_();
+		std::size_t first( tick_source_);
+		tick_source_ = ( tick_source_ + 1) % 3;
+		for ( std::size_t i = 0; i < 3; ++i)
+		{
+			switch ( ( first + i) % 3)
+			{
+			case 0:
+				if ( try_take_posted_work_( w) || try_take_global_work_( w) ) return true;
+				break;
+			case 1:
+				if ( try_take_ready_work_( w) ) return true;
+				break;
+			default:
+				if ( try_search_work_( w) ) return true;
+				break;
+			}
+		}
+		return false;
+	}
+
+	void schedule_()
+	{
+		worker_descriptor & desc( this_worker() );
+		last_tick_ = pool_.now_();
+		publish_cpu_();
+		while ( ! shutdown_() )
+		{
+			work w;
+			// a standby worker-thread finishes its own work-items but
+			// takes nothing from the global queue or other worker-threads
+			bool standby( idx_ >= pool_.active_.load( memory_order_relaxed) );
+			// a lane worker-thread takes only tasks at or above the lane
+			// threshold from the global queue and does not steal - on
+			// shutdown it helps to drain the global queue
+			bool lane( pool_.lane_( idx_) && ! shutdown__() );
+			if ( ! standby && ! lane && tick_due_() && try_take_tick_work_( w) )
+				next_runs_ = 0;
+			else if ( try_take_next_work_( w, true) )
+				++next_runs_;
+			else if ( try_take_local_work_( w) || 
+				 try_take_ready_work_( w) ||
+				 ( lane && try_take_lane_work_( w) ) ||
+				 ( ! lane && try_take_posted_work_( w) ) ||
+				 ( ! standby && ! lane && try_take_global_work_( w) ) ||
+				 ( ! standby && ! lane && try_search_work_( w) ) ||
+				 try_take_next_work_( w, false) )
+				next_runs_ = 0;
+			else
+			{
+				if ( lane) lane_park_();
+				else if ( standby) standby_();
+				else
+				{
+					idle_();
+					// became a lane or standby worker-thread while
+					// parked - the wake-up may have been meant for a
+					// general one
+					if ( pool_.lane_( idx_) ||
+						 idx_ >= pool_.active_.load( memory_order_relaxed) )
+						pool_.notify_();
+				}
+				continue;
+			}
+			// executed by a waiting thread in the meantime
+			if ( w.is_claimed() ) continue;
+
+			desc.active = & w;
+			try
+			{
+				// with lazy fibers a work-item runs on the scheduler's stack
+				// until it suspends the first time (see promote())
+				if ( ! w.is_started() && pool_.lazy_fibers_.load( memory_order_relaxed) )
+				{
+					if ( ! w.run_inline( * this) )
+					{
+						desc.active = 0;
+						return;
+					}
+				}
+				else
+					w.run( stacks_);
+			}
+			catch ( thread_interrupted const&)
+			{}
+			desc.active = 0;
+			suspend_( w);
+		}
+	}
+
+	ctx::fcontext_t * promote( work & w, intptr_t & vp)
+	{
+		count_( promotions_);
+		pinned_.push_back( new work( boost::move( w) ) );
+		stack stk( stacks_.allocate() );
+		uintptr_t top( reinterpret_cast< uintptr_t >( stk.sp) - sizeof( scheduler_frame) );
+		top &= ~static_cast< uintptr_t >( 15);
+		scheduler_frame * f( reinterpret_cast< scheduler_frame * >( top) );
+		f->self = this;
+		f->stk = stk;
+		vp = reinterpret_cast< intptr_t >( f);
+		return ctx::make_fcontext(
+			reinterpret_cast< void * >( top),
+			stk.size - ( reinterpret_cast< uintptr_t >( stk.sp) - top),
+			& worker_object::scheduler_entry_);
+	}
+
+	void handoff( ctx::fcontext_t const& ctx, exception_ptr const& except)
+	{
+		handoff_ctx_ = ctx;
+		handoff_except_ = except;
+		superseded_ = true;
+	}
+
+	// passes control to the scheduler which resumed the completed promoted
+	// work-item, the calling scheduler has terminated
+	intptr_t supersede_( ctx::fcontext_t * own, stack const& stk)
+	{
+		work::handoff h;
+		h.stk = stk;
+		h.except = handoff_except_;
+		handoff_except_ = exception_ptr();
+		superseded_ = false;
+		return ctx::jump_fcontext( own, & handoff_ctx_, reinterpret_cast< intptr_t >( & h) );
+	}
+
+	static void scheduler_entry_( intptr_t vp)
+	{
+		scheduler_frame * f( reinterpret_cast< scheduler_frame * >( vp) );
+		worker_object * self( f->self);
+		self->schedule_();
+		ctx::fcontext_t own;
+		if ( self->superseded_)
+			self->supersede_( & own, f->stk);
+		else
+		{
+			// shut down - return to the thread's stack
+			work::handoff h;
+			h.stk = f->stk;
+			ctx::jump_fcontext( & own, & self->native_ctx_, reinterpret_cast< intptr_t >( & h) );
+		}
+		BOOST_ASSERT( false && "terminated scheduler resumed");
+	}
 	
+	// all worker-threads of a pool are of this type - the queues of
+	// other worker-threads are accessed without virtual calls
+	static worker_object * peer_( worker * other)
+	{ return static_cast< worker_object * >( other); }
+
+	bool try_steal_from_( worker_object & other, work & w, std::size_t batch, topology::level distance)
+	{
+		count_( steal_attempts_);
+		std::size_t n( 1 < batch
+				? other.wsq_.try_steal( w, wsq_, batch)
+				: ( other.wsq_.try_steal( w) ? 1 : 0) );
+		if ( 0 == n) return false;
+		count_( steals_);
+		count_( stolen_, n);
+		// an unknown CPU is ranked remote but not counted as remote steal
+		if ( topology::remote == distance && 0 <= cpu() && 0 <= other.cpu() )
+			count_( remote_steals_);
+		return true;
+	}
+
 	bool try_steal_other_work_( work & w)
 	{
+		if ( ! policy_type::stealing) return false;
+
+		// with a steal-batch greater than one, up to half of the victim's
+		// worker-queue is moved into the own worker-queue with one probe
+		std::size_t batch(
+			( std::min)(
+				pool_.steal_batch_.load( memory_order_relaxed) - 1,
+				room_() ) + 1);
+		// hierarchical victim selection: SMT siblings first, then workers
+		// sharing the last-level cache, the NUMA node and remote nodes
+		// (random_steal does not query the topology)
+		bool hierarchical(
+			policy_type::topology && pool_.topology_aware_.load( memory_order_relaxed) );
+		int cpu( policy_type::topology ? publish_cpu_() : -1);
+
+		// workers come and go in a resizable pool - the pinned array
+		// of the worker-group stays valid while it is scanned
+		// the reader protects the arrays of the victims' worker-queues too
+		worker_registry::reader wg( pool_.wg_.registry(), idx_, true);
+
+		std::size_t size( wg->size() );
 		std::size_t idx( rnd_idx_() );
-		for ( std::size_t j = 0; j < pool_.wg_.size(); ++j)
+		if ( ! hierarchical)
+		{
+			for ( std::size_t j = 0; j < size; ++j, ++idx)
+			{
+				if ( idx >= size) idx = 0;
+				worker * other( ( * wg)[idx]);
+				if ( ! other || this == other) continue;
+				topology::level distance(
+					policy_type::topology
+						? topology::instance().distance( cpu, other->cpu() )
+						: topology::smt);
+				if ( try_steal_from_( * peer_( other), w, batch, distance) )
+					return true;
+			}
+			return false;
+		}
+
+		// the victims are sorted into the tiers with one pass, each tier
+		// is probed starting at the same random index
+		topology const& topo( topology::instance() );
+		for ( unsigned int level = 0; level < topology::levels; ++level)
+			victims_[level].clear();
+		for ( std::size_t j = 0; j < size; ++j, ++idx)
 		{
-			worker_object other( pool_.wg_[idx]);
-			if ( this_thread::get_id() == other.get_id() ) continue;
-			if ( ++idx >= pool_.wg_.size() ) idx = 0;
-			if ( other.try_steal( w) )
+			if ( idx >= size) idx = 0;
+			worker * other( ( * wg)[idx]);
+			if ( ! other || this == other) continue;
+			victims_[topo.distance( cpu, other->cpu() )].push_back( idx);
+		}
+		for ( unsigned int level = 0; level < topology::levels; ++level)
+		{
+			std::vector< std::size_t > const& tier( victims_[level]);
+			for ( std::size_t j = 0; j < tier.size(); ++j)
+			{
+				worker * other( ( * wg)[tier[j]]);
+				if ( try_steal_from_(
+						* peer_( other), w, batch, static_cast< topology::level >( level) ) )
+					return true;
+			}
+		}
+		return false;
+	}
+
+	// the CPU a worker-thread runs on is published when it looks for
+	// work and at each fairness-tick - a busy worker-thread which never
+	// steals is ranked correctly by the thieves too
+	int publish_cpu_()
+	{
+		if ( ! policy_type::topology) return -1;
+		int cpu( topology::current_cpu() );
+		cpu_.store( cpu, memory_order_relaxed);
+		return cpu;
+	}
+
+	// suspended work-items of other worker-threads are stolen only if
+	// no task is left - one at a time, because their stacks are hot
+	// in the cache of the owner
+	bool try_steal_ready_work_( work & w)
+	{
+		if ( ! policy_type::stealing) return false;
+
+		worker_registry::reader wg( pool_.wg_.registry(), idx_, true);
+
+		std::size_t size( wg->size() );
+		std::size_t idx( rnd_idx_() );
+		for ( std::size_t j = 0; j < size; ++j, ++idx)
+		{
+			if ( idx >= size) idx = 0;
+			worker * other( ( * wg)[idx]);
+			if ( ! other || this == other) continue;
+			count_( steal_attempts_);
+			if ( peer_( other)->ready_.try_steal( w) )
+			{
+				count_( steals_);
+				count_( stolen_);
 				return true;
+			}
+		}
+		return false;
+	}
+
+	// the run-next slots of other worker-threads are probed last - a
+	// slot left alone while its owner is busy is not delayed further
+	// a slot is taken only after a grace period - the owner picks it up
+	// at once if it is running; the grace period is waited once per
+	// scan, before the first occupied slot is claimed
+	bool try_steal_next_work_( work & w)
+	{
+		if ( ! policy_type::stealing) return false;
+
+		worker_registry::reader wg( pool_.wg_.registry(), idx_, pool_.resizable_);
+
+		bool graced( false);
+		std::size_t size( wg->size() );
+		std::size_t idx( rnd_idx_() );
+		for ( std::size_t j = 0; j < size; ++j, ++idx)
+		{
+			if ( idx >= size) idx = 0;
+			worker * other( ( * wg)[idx]);
+			if ( ! other || this == other) continue;
+			worker_object * peer( peer_( other) );
+			callable_base * ca( peer->next_.load( memory_order_relaxed) );
+			if ( ! ca) continue;
+			if ( ! graced)
+			{
+				for ( std::size_t i = 0; i < next_grace; ++i)
+					BOOST_TASK_CPU_RELAX();
+				graced = true;
+			}
+			if ( try_steal_next_from_( * peer, ca, w) ) return true;
 		}
 		return false;
 	}
 
+	// tasks posted to a busy worker-thread are taken over if they
+	// waited for longer than affinity_delay
+	bool try_steal_posted_work_( work & w)
+	{
+		if ( ! policy_type::stealing) return false;
+
+		boost::int64_t posted_before( pool_.now_() - Pool::affinity_delay);
+		worker_registry::reader wg( pool_.wg_.registry(), idx_, pool_.resizable_);
+
+		std::size_t size( wg->size() );
+		std::size_t idx( rnd_idx_() );
+		for ( std::size_t j = 0; j < size; ++j, ++idx)
+		{
+			if ( idx >= size) idx = 0;
+			worker * other( ( * wg)[idx]);
+			if ( ! other || this == other) continue;
+			worker_object * peer( peer_( other) );
+			boost::int64_t oldest( peer->inbox_.oldest() );
+			if ( -1 == oldest || oldest >= posted_before) continue;
+			count_( steal_attempts_);
+			callable ca;
+			if ( peer->inbox_.try_steal( ca, posted_before) )
+			{
+				pool_.posted_taken_();
+				work tmp( ca);
+				w = boost::move( tmp);
+				count_( steals_);
+				count_( stolen_);
+				count_( posted_stolen_);
+				return true;
+			}
+		}
+		return false;
+	}
+
+	bool try_search_work_( work & w)
+	{
+		// only one worker-thread searches the other worker-queues at a
+		// time - if it finds work it wakes up a successor, so that the
+		// number of awake worker-threads follows the amount of work
+		if ( ! pool_.idle_.begin_search() ) return false;
+		bool found(
+			try_steal_other_work_( w) ||
+			try_take_global_work_( w) ||
+			try_steal_posted_work_( w) ||
+			try_steal_ready_work_( w) ||
+			try_steal_next_work_( w) );
+		if ( pool_.idle_.end_search() )
+		{
+			// producers did not wake anybody while this worker-thread
+			// was searching - work queued behind its scan is handed on
+			if ( found || pool_.has_work_( idx_) ) pool_.notify_();
+		}
+		return found;
+	}
+
+	bool try_take_lane_work_( work & w)
+	{
+		callable ca;
+		if ( ! pool_.take_lane_( ca) ) return false;
+		pool_.taken_();
+		work tmp( ca);
+		w = boost::move( tmp);
+		return true;
+	}
+
+	// a lane worker-thread parks apart from the others, it is woken up
+	// by tasks at or above the lane threshold only
+	void lane_park_()
+	{
+		pool_.lanes_idle_.add( idx_);
+		atomic_thread_fence( memory_order_seq_cst);
+		if ( ! empty() || pool_.has_lane_work_() || ! pool_.lane_( idx_) ||
+			 shutdown__() || shutdown_now__() )
+		{
+			if ( ! pool_.lanes_idle_.remove( idx_) ) parker_.park();
+			return;
+		}
+		count_( parks_);
+		parker_.park();
+	}
+
+	// the CPU quota allows fewer worker-threads than the pool contains -
+	// parks until activated, work-items which become ready or are posted
+	// meanwhile are picked up by the periodic re-check (or stolen)
+	void standby_()
+	{
+		count_( parks_);
+		parker_.park_for( posix_time::milliseconds( 100) );
+	}
+
+	// no work was found - the worker-thread busy-waits, yields or parks
+	// depending on the idle strategy of the pool
+	void idle_()
+	{
+		int mode(
+			0 > policy_type::idle_mode
+				? pool_.idle_mode_.load( memory_order_relaxed)
+				: policy_type::idle_mode);
+		if ( idle_strategy::park == mode)
+		{
+			park_();
+			return;
+		}
+		// spinning is measured in CPU time of the worker-thread - a
+		// preempted spinner neither uses up its window nor inflates
+		// spin_time, parking in wall time because the thread does not run
+		boost::int64_t start( thread_cpu_now() );
+		boost::int64_t limit( -1);
+		if ( idle_strategy::adaptive == mode)
+			limit = ( std::max)(
+				( std::min)( spin_window_, pool_.idle_window_.load( memory_order_relaxed) ),
+				boost::int64_t( 0) );
+		bool found( spin_( mode, start, limit) );
+		boost::int64_t interval( elapsed_( start, thread_cpu_now() ) );
+		count_( spin_time_, static_cast< std::size_t >( interval) );
+		if ( ! found)
+		{
+			boost::int64_t parked( pool_.now_() );
+			park_();
+			interval += elapsed_( parked, pool_.now_() );
+		}
+		if ( idle_strategy::adaptive == mode) adapt_( interval);
+	}
+
+	// both clocks are monotonic - clamped anyway, a negative interval must
+	// not turn into an endless spin window or a huge counter increment
+	static boost::int64_t elapsed_( boost::int64_t start, boost::int64_t now)
+	{ return ( std::max)( now - start, boost::int64_t( 0) ); }
+
+	// a spinning worker-thread takes the searching role if it is free, so
+	// that producers do not wake up a parked worker-thread - it wakes up a
+	// successor if it finds work
+	// only the searcher polls the queues of the pool, the other spinning
+	// worker-threads poll their own inbox and worker-queue and retry to
+	// become the searcher, so that they do not contend on shared lines
+	// limit is the spin window in microseconds of CPU time since start,
+	// -1 spins until work arrives
+	bool spin_( int mode, boost::int64_t start, boost::int64_t limit)
+	{
+		bool searching( pool_.idle_.begin_search() );
+		bool found( false);
+		std::size_t polls( 0);
+		while ( ! found)
+		{
+			if ( ! searching && 0 == pool_.idle_.searching() )
+				searching = pool_.idle_.begin_search();
+			if ( ! inbox_.empty() || ! empty() || shutdown_() ||
+				 ( searching && pool_.has_work_( idx_) ) )
+				found = true;
+			else if ( 0 <= limit &&
+					  ( 0 == limit || 0 == ++polls % spin_checks) &&
+					  elapsed_( start, thread_cpu_now() ) >= limit)
+				break;
+			else if ( idle_strategy::yield == mode)
+				this_thread::yield();
+			else
+				for ( std::size_t i = 0; i < spin_pauses; ++i)
+					BOOST_TASK_CPU_RELAX();
+		}
+		if ( searching && pool_.idle_.end_search() && found) pool_.notify_();
+		return found;
+	}
+
+	// the spin window follows twice the smoothed interval between going
+	// idle and new work (CPU time spun plus wall time parked) - intervals
+	// longer than the window of the idle strategy shrink it, so that a
+	// worker-thread which waits long parks at once
+	void adapt_( boost::int64_t interval)
+	{
+		boost::int64_t max( pool_.idle_window_.load( memory_order_relaxed) );
+		boost::int64_t target( interval < max ? 2 * interval : 0);
+		spin_window_ = ( std::max)(
+			( std::min)( max, ( 3 * spin_window_ + target) / 4),
+			boost::int64_t( 0) );
+	}
+
+	void park_()
+	{
+		pool_.idle_.add( idx_);
+		atomic_thread_fence( memory_order_seq_cst);
+		// re-check after the announcement - a producer which has not
+		// seen it has made its work visible before
+		// work in the worker-queues of other worker-threads is left to
+		// the searching worker-thread, it wakes up a successor if it
+		// finds work - only without a searcher they are scanned here
+		if ( ! inbox_.empty() || ! empty() || ! pool_.queue_.empty() ||
+			 shutdown_() ||
+			 ( 0 == pool_.idle_.searching() && pool_.has_work_( idx_) ) )
+		{
+			// another thread claimed this worker - consume its wake-up
+			if ( ! pool_.idle_.remove( idx_) ) parker_.park();
+			return;
+		}
+		count_( parks_);
+		// tasks posted to busy worker-threads - wake up when
+		// they may be stolen
+		boost::int64_t due( policy_type::stealing ? pool_.posted_due_( idx_) : -1);
+		if ( -1 != due)
+		{
+			posix_time::time_duration timeout(
+				posix_time::microseconds( ( std::max)( due - pool_.now_(), boost::int64_t( 0) ) ) );
+			if ( ! parker_.park_for( timeout) && ! pool_.idle_.remove( idx_) )
+				parker_.park();
+			return;
+		}
+		if ( ! pool_.resizable_)
+		{
+			parker_.park();
+			return;
+		}
+		// idle for keep_alive - retire unless the pool is at its minimum size
+		while ( ! parker_.park_for( pool_.keep_alive_) )
+		{
+			if ( pool_.retire_( idx_) )
+			{
+				retired_ = true;
+				return;
+			}
+		}
+	}
+
 	bool shutdown_()
 	{
-		if ( shutdown__() && pool_.queue_.empty() )
+		// promoted work-items always complete
+		if ( ! pinned_.empty() )
+			return false;
+		else if ( retired_)
+			return true;
+		else if ( shutdown__() && pool_.queue_.empty() && wsq_.empty() && ready_.empty() && inbox_.empty() && ! next_.load( memory_order_relaxed) )
 			return true;
 		else if ( shutdown_now__() )
 			return true;
@@ -179,10 +1161,39 @@ private:
 	{ return pool_.shtdwn_now_; }
 
 	Pool		&	pool_;
-	thread			thrd_;
+	std::size_t		idx_;
+	mutable thread	thrd_;
 	wsq				wsq_;
+	// suspended work-items which can be resumed by any worker-thread
+	wsq				ready_;
+	// tasks submitted to this worker-thread with an affinity hint
+	inbox			inbox_;
+	bool			ready_turn_;
+	// callable spawned last, executed before the worker-queue - other
+	// worker-threads steal it after a grace period
+	atomic< callable_base * >	next_;
+	std::size_t		next_runs_;
+	// tasks executing inline which were spawned on this worker-thread
+	atomic< std::size_t >	inline_depth_;
+	// work-items taken since the last fairness-tick
+	std::size_t		tick_runs_;
+	boost::int64_t	last_tick_;
+	std::size_t		tick_source_;
+	// current spin window of the adaptive idle strategy (microseconds)
+	boost::int64_t	spin_window_;
+	stack_cache		stacks_;
+	// promoted work-items, they must not be stolen because their stacks
+	// contain frames of this worker's scheduler
+	pinned_t		pinned_;
+	bool			superseded_;
+	ctx::fcontext_t	native_ctx_;
+	ctx::fcontext_t	handoff_ctx_;
+	exception_ptr	handoff_except_;
 	bool			shtdwn_;
+	bool			retired_;
 	random_idx		rnd_idx_;
+	// steal victims sorted by their distance, reused at each steal
+	std::vector< std::size_t >	victims_[topology::levels];
 };
 
 }}}
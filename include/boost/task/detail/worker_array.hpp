@@ -0,0 +1,156 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_TASKS_DETAIL_WORKER_ARRAY_H
+#define BOOST_TASKS_DETAIL_WORKER_ARRAY_H
+
+#include <cstddef>
+#include <vector>
+
+#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/scoped_array.hpp>
+#include <boost/utility.hpp>
+
+#include <boost/task/detail/config.hpp>
+
+# if defined(BOOST_MSVC)
+# pragma warning(push)
+# pragma warning(disable:4251 4275)
+# endif
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_PREFIX
+#endif
+
+namespace boost {
+namespace tasks {
+namespace detail {
+
+class worker;
+
+// immutable array of the worker-threads of a pool indexed by the
+// worker index, slots of workers which are not running are null
+class BOOST_TASK_DECL worker_array : private noncopyable
+{
+private:
+	friend class worker_registry;
+
+	std::vector< worker * >		slots_;
+	boost::uint64_t				replaced_;
+	worker_array			*	next_;
+
+public:
+	explicit worker_array( std::size_t);
+
+	// copy of other with the slot idx set to w
+	worker_array( worker_array const&, std::size_t, worker *);
+
+	std::size_t size() const
+	{ return slots_.size(); }
+
+	worker * operator[]( std::size_t i) const
+	{ return slots_[i]; }
+};
+
+// publishes the current worker_array of a pool - a resize publishes a
+// new array, the replaced one is deleted after its readers are gone
+//
+// a reader announces the epoch it entered in its own slot (one store
+// and one fence, no read-modify-write) - arrays replaced in an epoch
+// not older than the oldest announced one may still be read
+//
+// the worker-queues retire their replaced arrays in the same epochs,
+// a worker-thread stealing from them reads through a reader
+class BOOST_TASK_DECL worker_registry : private noncopyable
+{
+private:
+	struct slot
+	{
+		// 0 if the reader is not reading
+		atomic< boost::uint64_t >	epoch;
+		char						pad[64 - sizeof( atomic< boost::uint64_t >)];
+
+		slot() :
+			epoch( 0)
+		{}
+	};
+
+	atomic< worker_array * >	current_;
+	atomic< boost::uint64_t >	epoch_;
+	std::size_t					readers_;
+	scoped_array< slot >		slots_;
+	worker_array			*	limbo_;
+
+	boost::uint64_t oldest_() const;
+
+public:
+	// pins the current worker_array for the reader with the given
+	// index - without protection the array must not be replaced
+	// while it is read (the pool is not resizable)
+	class reader : private noncopyable
+	{
+	private:
+		slot				*	slot_;
+		worker_array const	*	array_;
+
+	public:
+		reader( worker_registry const& registry, std::size_t idx, bool protect) :
+			slot_( 0), array_( 0)
+		{
+			if ( protect)
+			{
+				slot_ = & registry.slots_[idx];
+				slot_->epoch.store(
+					registry.epoch_.load( memory_order_acquire), memory_order_relaxed);
+				atomic_thread_fence( memory_order_seq_cst);
+			}
+			array_ = registry.current_.load( memory_order_acquire);
+		}
+
+		~reader()
+		{ if ( slot_) slot_->epoch.store( 0, memory_order_release); }
+
+		worker_array const& operator*() const
+		{ return * array_; }
+
+		worker_array const* operator->() const
+		{ return array_; }
+	};
+
+	// the array has size slots, one reader per slot
+	worker_registry( std::size_t size);
+
+	~worker_registry();
+
+	// the writer side - publish() and reclaim() must be serialized
+	worker_array const& current() const;
+
+	void publish( worker_array *);
+
+	// deletes the replaced arrays which can not be read any more,
+	// returns true if no replaced array is left
+	bool reclaim();
+
+	// thread-safe - starts a new epoch and returns the previous one,
+	// in which a retired object may still be read
+	boost::uint64_t advance();
+
+	// true if no reader entered in the given epoch or before
+	bool quiescent( boost::uint64_t) const;
+};
+
+}}}
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_SUFFIX
+#endif
+
+# if defined(BOOST_MSVC)
+# pragma warning(pop)
+# endif
+
+#endif // BOOST_TASKS_DETAIL_WORKER_ARRAY_H
@@ -10,11 +10,14 @@
 #include <cstddef>
 #include <vector>
 
+#include <boost/assert.hpp>
+#include <boost/atomic.hpp>
 #include <boost/config.hpp>
 #include <boost/thread.hpp>
 
 #include <boost/task/detail/config.hpp>
 #include <boost/task/detail/worker.hpp>
+#include <boost/task/detail/worker_array.hpp>
 
 #ifdef BOOST_HAS_ABI_HEADERS
 #  include BOOST_ABI_PREFIX
@@ -24,43 +27,96 @@ namespace boost {
 namespace tasks {
 namespace detail {
 
+// worker-threads are stored in slots indexed by their worker index
+// the number of slots is fixed at construction (the maximum pool size),
+// slots of workers which are not running are empty
+// adding and retiring workers must be serialized by the pool - the
+// worker-threads scan the slots through the registry without a lock
 class BOOST_TASK_DECL worker_group
 {
 private:
 	typedef std::vector< worker::ptr_t >	container_t;
 
-	container_t	worker_;
+	container_t				worker_;
+	container_t				retired_;
+	// joined workers which may still be read by other worker-threads
+	container_t				joined_;
+	atomic< std::size_t >	size_;
+	worker_registry			registry_;
 
-public:
-	typedef container_t::iterator		iterator;
-	typedef container_t::const_iterator	const_iterator;
+	void publish_( std::size_t);
 
+public:
 	template< typename Pool >
-	worker_group( Pool const& pool, std::size_t size) :
-		worker_()
+	worker_group( Pool & pool, std::size_t size, std::size_t max) :
+		worker_( max), retired_(), joined_(), size_( size), registry_( max)
 	{
-		for ( int i = 0; i < size; ++i)
-			worker_.push_back( worker::create( pool) );
+		BOOST_ASSERT( size <= max);
+		for ( std::size_t i = 0; i < size; ++i)
+		{
+			worker_[i] = worker_object< Pool >::create( pool, max, i);
+			publish_( i);
+		}
 	}
 
 	~worker_group();
 
+	// creates and starts a worker-thread in the first empty slot
+	// returns false if all slots are used
+	template< typename Pool >
+	bool add( Pool & pool)
+	{
+		join_retired();
+		for ( std::size_t i = 0; i < worker_.size(); ++i)
+		{
+			if ( worker_[i]) continue;
+			worker_[i] = worker_object< Pool >::create( pool, worker_.size(), i);
+			publish_( i);
+			worker_[i]->start();
+			size_.fetch_add( 1);
+			return true;
+		}
+		return false;
+	}
+
+	// called by the worker-thread itself - it is joined later
+	void retire( std::size_t);
+
+	// joins the retired worker-threads and releases the joined ones
+	// and the replaced slot arrays which can not be read any more
+	void join_retired();
+
+	// number of running worker-threads
 	std::size_t size() const;
 
+	// number of slots
+	std::size_t capacity() const;
+
 	bool empty() const;
 
-	const worker::ptr_t operator[]( std::size_t) const;
+	// null if the slot is not used - no reference is taken, the caller
+	// holds the pool's lock or has claimed the parked worker-thread, so
+	// that the slot is not emptied meanwhile
+	worker * operator[]( std::size_t) const;
 
-	const iterator begin();
-	const const_iterator begin() const;
+	// the worker-threads pin the slots with a worker_registry::reader
+	worker_registry const& registry() const;
 
-	const iterator end();
-	const const_iterator end() const;
+	// the worker-queues retire their arrays through the registry
+	worker_registry & registry();
 
 	void start_all();
 
+	// the joined worker-threads stay in their slots until clear()
 	void join_all();
 
+	// drops the tasks left in the run-next slots, the worker-queues and
+	// the inboxes of the joined worker-threads
+	void discard_all();
+
+	// empties the slots - no worker-thread is left to read them
+	void clear();
+
 	void interrupt_all();
 };
 
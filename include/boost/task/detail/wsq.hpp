@@ -3,18 +3,23 @@
 // Distributed under the Boost Software License, Version 1.0.
 //    (See accompanying file LICENSE_1_0.txt or copy at
 //          http://www.boost.org/LICENSE_1_0.txt)
+//
+//  based on 'Dynamic Circular Work-Stealing Deque' (Chase, Lev) and
+//  'Correct and Efficient Work-Stealing for Weak Memory Models' (Le, Pop, Cohen, Nardelli)
 
 #ifndef BOOST_TASKS_DETAIL_WSQ_H
 #define BOOST_TASKS_DETAIL_WSQ_H
 
+#include <cstddef>
+
 #include <boost/atomic.hpp>
-#include <boost/shared_array.hpp>
-#include <boost/thread/mutex.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/move/move.hpp>
 #include <boost/utility.hpp>
 
 #include <boost/task/detail/config.hpp>
 #include <boost/task/detail/work.hpp>
-#include <boost/task/fast_semaphore.hpp>
+#include <boost/task/detail/worker_array.hpp>
 
 #include <boost/config/abi_prefix.hpp>
 
@@ -27,30 +32,107 @@ namespace boost {
 namespace tasks {
 namespace detail {
 
+// work-stealing deque
+// the owning worker pushes and pops at the bottom without locks,
+// other workers steal from the top with one CAS
+//
+// work-items are stored as two atomic words per slot, nothing is
+// allocated per push - a thief reads the words before its CAS, a value
+// read from a slot which was overwritten is dropped when the CAS fails
+//
+// replaced arrays are retired in the epochs of the worker_registry of
+// the pool: a thief must hold a worker_registry::reader while it steals
+// (one store and one fence per scan, no read-modify-write per steal)
 class BOOST_TASK_DECL wsq : private noncopyable
 {
 private:
-	const int					initial_size_;
-	shared_array< work >		array_;
-	int							capacity_;
-	int							mask_;
-	atomic< unsigned int >		head_idx_;
-	atomic< unsigned int >		tail_idx_;
-	recursive_mutex				mtx_;
-	fast_semaphore			&	fsem_;
+	typedef boost::int64_t	index_t;
+
+	struct slot
+	{
+		atomic< callable_base * >	ca;
+		atomic< void * >			fib;
+	};
+
+	struct array
+	{
+		std::size_t			capacity;
+		index_t				mask;
+		slot			*	slots;
+		// epoch of the registry in which the array was replaced
+		boost::uint64_t		replaced;
+		array			*	next;
+
+		array( std::size_t);
+
+		~array();
+
+		work::raw get( index_t i) const
+		{
+			slot const& s( slots[i & mask]);
+			work::raw r;
+			r.ca = s.ca.load( memory_order_relaxed);
+			r.fib = s.fib.load( memory_order_relaxed);
+			return r;
+		}
+
+		void put( index_t i, work::raw const& r)
+		{
+			slot & s( slots[i & mask]);
+			s.ca.store( r.ca, memory_order_relaxed);
+			s.fib.store( r.fib, memory_order_relaxed);
+		}
+
+		array * resize( index_t, index_t, std::size_t) const;
+	};
+
+	static const std::size_t	initial_capacity = 32;
+	// shrink if less than 1/shrink_factor of the slots are used
+	static const std::size_t	shrink_factor = 4;
+
+	worker_registry			&	registry_;
+	array					*	retired_;
+	// top_ is written by thieves, bottom_ by the owner only
+	// keep them on different cache lines
+	char						pad0_[64];
+	atomic< index_t >			top_;
+	char						pad1_[64];
+	atomic< index_t >			bottom_;
+	atomic< array * >			array_;
+	char						pad2_[64];
+
+	void retire_( array *);
+
+	void reclaim_();
+
+	void resize_( index_t, index_t, std::size_t);
+
+	void push_( work::raw const&);
+
+	bool take_( work::raw &);
+
+	bool steal_( work::raw &);
 
 public:
-	wsq( fast_semaphore & fsem);
+	// thieves announce themselves in the registry
+	wsq( worker_registry &);
+
+	~wsq();
 
 	bool empty() const;
 
 	std::size_t size() const;
 
-	void put( work const&);
+	// number of slots of the current array
+	std::size_t capacity() const;
+
+	void put( BOOST_RV_REF( work) );
 
 	bool try_take( work &);
 
 	bool try_steal( work &);
+
+	std::size_t try_steal( work &, wsq &, std::size_t);
 };
 
 }}}
@@ -0,0 +1,90 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_TASKS_DYNAMIC_POOL_H
+#define BOOST_TASKS_DYNAMIC_POOL_H
+
+#include <boost/config.hpp>
+#include <boost/context/stack_utils.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/move/move.hpp>
+
+#include <boost/task/basic_pool.hpp>
+#include <boost/task/pool_policy.hpp>
+#include <boost/task/poolsize.hpp>
+#include <boost/task/stacksize.hpp>
+#include <boost/task/watermark.hpp>
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_PREFIX
+#endif
+
+namespace boost {
+namespace tasks {
+
+// the number of worker-threads varies between min_size and max_size
+// a worker-thread is added if the pool is overloaded - no worker-thread
+// is idle and the global queue has a backlog or was not served for
+// max_latency; a worker-thread idle for keep_alive terminates
+template< typename Queue >
+class dynamic_pool : public basic_pool< Queue, dynamic_pool_policy >
+{
+private:
+	typedef basic_pool< Queue, dynamic_pool_policy >	base_type;
+
+	BOOST_MOVABLE_BUT_NOT_COPYABLE( dynamic_pool);
+
+public:
+	dynamic_pool() :
+		base_type()
+	{}
+
+	dynamic_pool(
+			poolsize const& min_size,
+			poolsize const& max_size,
+			posix_time::time_duration const& keep_alive = posix_time::seconds( 60),
+			posix_time::time_duration const& max_latency = posix_time::milliseconds( 10),
+			stacksize const& stack_size = stacksize( ctx::default_stacksize() ) ) :
+		base_type( min_size, max_size, keep_alive, max_latency, stack_size)
+	{}
+
+	dynamic_pool(
+			poolsize const& min_size,
+			poolsize const& max_size,
+			high_watermark const& hwm,
+			low_watermark const& lwm,
+			posix_time::time_duration const& keep_alive = posix_time::seconds( 60),
+			posix_time::time_duration const& max_latency = posix_time::milliseconds( 10),
+			stacksize const& stack_size = stacksize( ctx::default_stacksize() ) ) :
+		base_type( min_size, max_size, hwm, lwm, keep_alive, max_latency, stack_size)
+	{}
+
+	dynamic_pool( BOOST_RV_REF( dynamic_pool) other) :
+		base_type( boost::move( static_cast< base_type & >( other) ) )
+	{}
+
+	dynamic_pool & operator=( BOOST_RV_REF( dynamic_pool) other)
+	{
+		base_type::operator=( boost::move( static_cast< base_type & >( other) ) );
+		return * this;
+	}
+
+	void swap( dynamic_pool & other) // throw()
+	{ base_type::swap( other); }
+};
+
+template< typename Queue >
+void swap( tasks::dynamic_pool< Queue > & l, tasks::dynamic_pool< Queue > & r)
+{ return l.swap( r); }
+
+}}
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_SUFFIX
+#endif
+
+#endif // BOOST_TASKS_DYNAMIC_POOL_H
+
@@ -23,6 +23,14 @@ public:
 	{}
 };
 
+class invalid_pool_bounds : public std::invalid_argument
+{
+public:
+	invalid_pool_bounds() :
+		std::invalid_argument("min poolsize must not be greater than max poolsize")
+	{}
+};
+
 class invalid_stacksize : public std::invalid_argument
 {
 public:
@@ -31,6 +39,62 @@ public:
 	{}
 };
 
+class invalid_steal_batch : public std::invalid_argument
+{
+public:
+    invalid_steal_batch() :
+		std::invalid_argument("steal batch must be greater than zero")
+	{}
+};
+
+class invalid_fairness_tick : public std::invalid_argument
+{
+public:
+    invalid_fairness_tick() :
+		std::invalid_argument("fairness tick must be greater than zero")
+	{}
+};
+
+class invalid_worker_capacity : public std::invalid_argument
+{
+public:
+    invalid_worker_capacity() :
+		std::invalid_argument("worker capacity must be greater than zero")
+	{}
+};
+
+class invalid_idle_strategy : public std::invalid_argument
+{
+public:
+    invalid_idle_strategy() :
+		std::invalid_argument("invalid idle strategy")
+	{}
+};
+
+class invalid_strand_count : public std::invalid_argument
+{
+public:
+    invalid_strand_count() :
+		std::invalid_argument("number of strands must be greater than zero")
+	{}
+};
+
+class invalid_processor_set : public std::invalid_argument
+{
+public:
+    invalid_processor_set() :
+		std::invalid_argument("processor set must contain available CPUs only and must not be empty")
+	{}
+};
+
+class invalid_latency_lanes : public std::invalid_argument
+{
+public:
+    invalid_latency_lanes() :
+		std::invalid_argument("latency lanes must leave at least one worker-thread for all tasks")
+	{}
+};
+
 class invalid_watermark : public std::invalid_argument
 {
 public:
@@ -0,0 +1,57 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_TASKS_FAIRNESS_TICK_H
+#define BOOST_TASKS_FAIRNESS_TICK_H
+
+#include <cstddef>
+
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+
+#include <boost/task/detail/config.hpp>
+
+# if defined(BOOST_MSVC)
+# pragma warning(push)
+# pragma warning(disable:4251 4275)
+# endif
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_PREFIX
+#endif
+
+namespace boost {
+namespace tasks {
+
+// a worker-thread polls the global queue, its suspended work items and the
+// worker-queues of other worker-threads before its own worker-queue after
+// the given number of executions or if the interval has elapsed
+class BOOST_TASK_DECL fairness_tick
+{
+private:
+	std::size_t					executions_;
+	posix_time::time_duration	interval_;
+
+public:
+	explicit fairness_tick(
+		std::size_t executions,
+		posix_time::time_duration const& interval = posix_time::milliseconds( 1) );
+
+	std::size_t executions() const;
+
+	posix_time::time_duration interval() const;
+};
+
+}}
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_SUFFIX
+#endif
+
+# if defined(BOOST_MSVC)
+# pragma warning(pop)
+# endif
+
+#endif // BOOST_TASKS_FAIRNESS_TICK_H
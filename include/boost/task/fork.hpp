@@ -37,9 +37,9 @@ fork( Fn fn)
     detail::promise< R > prom;
     detail::unique_future< R > f( prom.get_future() );
     context ctx;
-    task< R > t( f, ctx);
-    detail::worker::instance()->put(
-        callable( fn, boost::move( prom), ctx) );
+    callable ca( fn, boost::move( prom), ctx);
+    task< R > t( f, ctx, ca);
+    detail::worker::instance()->put( ca);
     return t;
 }
 
@@ -54,9 +54,9 @@ fork( BOOST_RV_REF( Fn) fn)
     detail::promise< R > prom;
     detail::unique_future< R > f( prom.get_future() );
     context ctx;
-    task< R > t( f, ctx);
-    detail::worker::instance()->put(
-        callable( boost::move( fn), boost::move( prom), ctx) );
+    callable ca( boost::move( fn), boost::move( prom), ctx);
+    task< R > t( f, ctx, ca);
+    detail::worker::instance()->put( ca);
     return t;
 }
 
@@ -0,0 +1,68 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_TASKS_IDLE_STRATEGY_H
+#define BOOST_TASKS_IDLE_STRATEGY_H
+
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+
+#include <boost/task/detail/config.hpp>
+
+# if defined(BOOST_MSVC)
+# pragma warning(push)
+# pragma warning(disable:4251 4275)
+# endif
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_PREFIX
+#endif
+
+namespace boost {
+namespace tasks {
+
+// what a worker-thread does if it finds no work
+//  - spin: busy-waits with a pause instruction, never parks
+//  - yield: yields the processor in a loop, never parks
+//  - park: sleeps until it is woken up by a producer
+//  - adaptive: spins up to window before it parks; the spin window
+//    follows the measured intervals between going idle and new work
+class BOOST_TASK_DECL idle_strategy
+{
+public:
+	enum mode
+	{
+		spin = 0,
+		yield,
+		park,
+		adaptive
+	};
+
+private:
+	mode						mode_;
+	posix_time::time_duration	window_;
+
+public:
+	explicit idle_strategy(
+		mode m,
+		posix_time::time_duration const& window = posix_time::microseconds( 50) );
+
+	mode get_mode() const;
+
+	// maximum spin window of the adaptive strategy
+	posix_time::time_duration window() const;
+};
+
+}}
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_SUFFIX
+#endif
+
+# if defined(BOOST_MSVC)
+# pragma warning(pop)
+# endif
+
+#endif // BOOST_TASKS_IDLE_STRATEGY_H
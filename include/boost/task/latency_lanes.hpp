@@ -0,0 +1,49 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_TASKS_LATENCY_LANES_H
+#define BOOST_TASKS_LATENCY_LANES_H
+
+#include <cstddef>
+
+#include <boost/task/detail/config.hpp>
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_PREFIX
+#endif
+
+namespace boost {
+namespace tasks {
+
+// reserves worker-threads of a pool with a priority queue for tasks
+// whose attribute is at or above a threshold - the other worker-threads
+// run all tasks, zero workers disables the lanes
+template< typename Attr >
+class latency_lanes
+{
+private:
+	std::size_t	workers_;
+	Attr		threshold_;
+
+public:
+	latency_lanes( std::size_t workers, Attr const& threshold) :
+		workers_( workers), threshold_( threshold)
+	{}
+
+	std::size_t workers() const
+	{ return workers_; }
+
+	Attr const& threshold() const
+	{ return threshold_; }
+};
+
+}}
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_SUFFIX
+#endif
+
+#endif // BOOST_TASKS_LATENCY_LANES_H
@@ -0,0 +1,122 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_TASKS_POOL_POLICY_H
+#define BOOST_TASKS_POOL_POLICY_H
+
+#include <boost/task/idle_strategy.hpp>
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_PREFIX
+#endif
+
+namespace boost {
+namespace tasks {
+
+// idle strategy - fixed at compile time or selected by idle() at run-time
+struct runtime_idle
+{ static const int mode = -1; };
+
+struct spin_idle
+{ static const int mode = idle_strategy::spin; };
+
+struct yield_idle
+{ static const int mode = idle_strategy::yield; };
+
+struct park_idle
+{ static const int mode = idle_strategy::park; };
+
+struct adaptive_idle
+{ static const int mode = idle_strategy::adaptive; };
+
+// steal strategy - victims ordered by the CPU topology (if enabled by
+// topology_aware()), victims in random order or no stealing at all
+struct hierarchical_steal
+{
+	static const bool enabled = true;
+	static const bool topology = true;
+};
+
+struct random_steal
+{
+	static const bool enabled = true;
+	static const bool topology = false;
+};
+
+struct no_steal
+{
+	static const bool enabled = false;
+	static const bool topology = false;
+};
+
+// interruption support - without it a task gets no context, which
+// saves an allocation per task, and task< R >::interrupt() has no effect
+struct interruptible
+{ static const bool value = true; };
+
+struct not_interruptible
+{ static const bool value = false; };
+
+// instrumentation - the counters of statistics()
+struct instrumented
+{ static const bool value = true; };
+
+struct not_instrumented
+{ static const bool value = false; };
+
+// sizing - a fixed number of worker-threads or a number varying between
+// a minimum and a maximum with the work-load
+struct fixed_size
+{ static const bool resizable = false; };
+
+struct variable_size
+{ static const bool resizable = true; };
+
+// compile-time components of a basic_pool - the branches of disabled
+// components are constants and compile away
+template<
+	typename Idle = runtime_idle,
+	typename Steal = hierarchical_steal,
+	typename Interruption = interruptible,
+	typename Instrumentation = instrumented,
+	typename Sizing = fixed_size
+>
+struct pool_policy
+{
+	typedef Idle			idle_type;
+	typedef Steal			steal_type;
+	typedef Interruption	interruption_type;
+	typedef Instrumentation	instrumentation_type;
+	typedef Sizing			sizing_type;
+
+	static const int	idle_mode = Idle::mode;
+	static const bool	stealing = Steal::enabled;
+	static const bool	topology = Steal::topology;
+	static const bool	interruption = Interruption::value;
+	static const bool	instrumentation = Instrumentation::value;
+	static const bool	resizable = Sizing::resizable;
+};
+
+// the components of static_pool
+typedef pool_policy<>	default_pool_policy;
+
+// the components of dynamic_pool
+typedef pool_policy<
+	runtime_idle, hierarchical_steal, interruptible, instrumented, variable_size
+>						dynamic_pool_policy;
+
+// no run-time switches, no interruption support, no counters
+typedef pool_policy<
+	park_idle, random_steal, not_interruptible, not_instrumented
+>						stripped_pool_policy;
+
+}}
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_SUFFIX
+#endif
+
+#endif // BOOST_TASKS_POOL_POLICY_H
@@ -27,10 +27,18 @@ class BOOST_TASK_DECL poolsize
 {
 private:
 	std::size_t	value_;
+	bool		automatic_;
 
 public:
 	explicit poolsize( std::size_t value);
 
+	// as many worker-threads as CPUs are available to the process - the
+	// affinity mask limited by the CPU quota of its cgroup (v1 or v2)
+	// a static_pool of this size follows later changes of the quota
+	static poolsize automatic();
+
+	bool is_automatic() const;
+
 	operator std::size_t () const;
 };
 
@@ -0,0 +1,73 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_TASKS_PROCESSOR_SET_H
+#define BOOST_TASKS_PROCESSOR_SET_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <boost/task/detail/bind_processor.hpp>
+#include <boost/task/detail/config.hpp>
+
+# if defined(BOOST_MSVC)
+# pragma warning(push)
+# pragma warning(disable:4251 4275)
+# endif
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_PREFIX
+#endif
+
+#if defined(BOOST_HAS_PROCESSOR_BINDINGS)
+
+namespace boost {
+namespace tasks {
+
+// CPUs the worker-threads of a pool are bound to - one worker-thread
+// per CPU, in the order of the set
+class BOOST_TASK_DECL processor_set
+{
+private:
+	std::vector< int >	cpus_;
+
+	void check_() const;
+
+public:
+	// the CPUs of the affinity mask of the calling thread
+	processor_set();
+
+	// the CPUs of a list like "0-3,8,10-11"
+	explicit processor_set( std::string const&);
+
+	template< typename Iterator >
+	processor_set( Iterator first, Iterator last) :
+		cpus_( first, last)
+	{ check_(); }
+
+	// one CPU per core - a busy-waiting worker-thread does not take the
+	// execution units of a worker-thread on its SMT sibling
+	processor_set without_smt_siblings() const;
+
+	std::size_t size() const;
+
+	int operator[]( std::size_t) const;
+};
+
+}}
+
+#endif
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_SUFFIX
+#endif
+
+# if defined(BOOST_MSVC)
+# pragma warning(pop)
+# endif
+
+#endif // BOOST_TASKS_PROCESSOR_SET_H
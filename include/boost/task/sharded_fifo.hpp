@@ -0,0 +1,405 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+//  shards are based on 'Non-intrusive MPSC node-based queue' (Vyukov)
+
+#ifndef BOOST_TASKS_SHARDED_FIFO_H
+#define BOOST_TASKS_SHARDED_FIFO_H
+
+#include <algorithm>
+#include <cstddef>
+
+#include <boost/assert.hpp>
+#include <boost/atomic.hpp>
+#include <boost/config.hpp>
+#include <boost/exception/all.hpp>
+#include <boost/functional/hash.hpp>
+#include <boost/intrusive_ptr.hpp>
+#include <boost/move/move.hpp>
+#include <boost/scoped_array.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/utility.hpp>
+
+#include <boost/task/detail/meta.hpp>
+#include <boost/task/detail/worker.hpp>
+#include <boost/task/exceptions.hpp>
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_PREFIX
+#endif
+
+namespace boost {
+namespace tasks {
+namespace detail {
+
+// unbounded FIFO split into one shard per worker-thread
+// producers push to a shard without a lock - the shard is chosen from
+// two candidates (the home shard of the producing thread and a rotating
+// one) by depth; worker-thread i drains shard i first and the others
+// afterwards, a shard is drained by one consumer at a time
+template< typename T >
+class sharded_fifo_base : private noncopyable
+{
+public:
+	typedef detail::has_no_attribute	attribute_tag_type;
+	typedef T       					value_type;
+
+private:
+	struct node
+	{
+		atomic< node * >	next;
+		value_type			va;
+
+		node() :
+			next( 0), va()
+		{}
+	};
+
+	struct shard : private noncopyable
+	{
+		atomic< node * >		head;
+		atomic< std::size_t >	producers;
+		char					pad1[64];
+		node				*	tail;
+		atomic< bool >			taking;
+		atomic< std::size_t >	count;
+		// dequeues of the owning consumer
+		atomic< std::size_t >	visits;
+		node					stub;
+		char					pad2[64];
+
+		shard() :
+			head( & stub), producers( 0), tail( & stub),
+			taking( false), count( 0), visits( 0), stub()
+		{}
+
+		~shard()
+		{
+			node * n( pop() );
+			while ( n)
+			{
+				delete n;
+				n = pop();
+			}
+		}
+
+		void push( node * n)
+		{
+			n->next.store( 0, memory_order_relaxed);
+			node * prev( head.exchange( n, memory_order_acq_rel) );
+			prev->next.store( n, memory_order_release);
+		}
+
+		// returns null if the shard is empty or a producer has
+		// not linked its node yet - caller must own taking
+		node * pop()
+		{
+			node * t( tail);
+			node * next( t->next.load( memory_order_acquire) );
+			if ( & stub == t)
+			{
+				if ( ! next) return 0;
+				tail = next;
+				t = next;
+				next = next->next.load( memory_order_acquire);
+			}
+			if ( next)
+			{
+				tail = next;
+				return t;
+			}
+			if ( t != head.load( memory_order_acquire) ) return 0;
+			push( & stub);
+			next = t->next.load( memory_order_acquire);
+			if ( ! next) return 0;
+			tail = next;
+			return t;
+		}
+
+		bool try_lock()
+		{ return ! taking.load( memory_order_relaxed) && ! taking.exchange( true, memory_order_acquire); }
+
+		void unlock()
+		{ taking.store( false, memory_order_release); }
+
+		std::size_t size() const
+		{ return count.load( memory_order_relaxed); }
+	};
+
+	// every fairness-th dequeue of a consumer starts at another shard,
+	// so that a shard without an active owner is not starved
+	static const std::size_t	fairness = 16;
+
+	enum state
+	{
+		ACTIVE = 0,
+		DEACTIVE
+	};
+
+    atomic< std::size_t >	use_count_;
+	atomic< state >			state_;
+	std::size_t				size_;
+	scoped_array< shard >	shards_;
+	mutable atomic< std::size_t >	rotation_;
+
+	static std::size_t default_shards_()
+	{ return ( std::max)( 1u, thread::hardware_concurrency() ); }
+
+	bool active_() const
+	{ return ACTIVE == state_.load(); }
+
+	// worker-thread i owns shard i, other threads are spread by their id
+	std::size_t home_() const
+	{
+		worker_descriptor const& desc( this_worker() );
+		if ( desc.self) return desc.index % size_;
+		return hash< thread::id >()( this_thread::get_id() ) % size_;
+	}
+
+	std::size_t choose_() const
+	{
+		std::size_t first( home_() );
+		if ( 1 == size_) return first;
+		std::size_t second(
+			( first + 1 + rotation_.fetch_add( 1, memory_order_relaxed) % ( size_ - 1) ) % size_);
+		return shards_[second].size() < shards_[first].size() ? second : first;
+	}
+
+	// the producer count of the shard keeps deactivate() from
+	// returning while a push is in flight
+	// the item is counted before it is linked, so that a consumer
+	// never takes more items than counted - size() may include an
+	// item which is not linked yet
+	bool push_( value_type const& va)
+	{
+		shard & s( shards_[choose_()]);
+		s.producers.fetch_add( 1, memory_order_seq_cst);
+		if ( ! active_() )
+		{
+			s.producers.fetch_sub( 1, memory_order_release);
+			return false;
+		}
+		node * n( new node);
+		n->va = va;
+		s.count.fetch_add( 1, memory_order_relaxed);
+		s.push( n);
+		s.producers.fetch_sub( 1, memory_order_release);
+		return true;
+	}
+
+	std::size_t start_( std::size_t home)
+	{
+		if ( 1 == size_) return home;
+		shard & s( shards_[home]);
+		std::size_t v( s.visits.load( memory_order_relaxed) + 1);
+		s.visits.store( v, memory_order_relaxed);
+		if ( 0 != v % fairness) return home;
+		return ( home + 1 + ( v / fairness) % ( size_ - 1) ) % size_;
+	}
+
+	std::size_t take_( shard & s, value_type * va, std::size_t n)
+	{
+		std::size_t i = 0;
+		while ( i < n)
+		{
+			node * nd( s.pop() );
+			if ( ! nd) break;
+			s.count.fetch_sub( 1, memory_order_relaxed);
+			va[i].swap( nd->va);
+			delete nd;
+			if ( ! va[i].empty() ) ++i;
+		}
+		return i;
+	}
+
+public:
+	sharded_fifo_base( std::size_t size = default_shards_() ) :
+		use_count_( 0),
+		state_( ACTIVE),
+		size_( ( std::max)( std::size_t( 1), size) ),
+		shards_( new shard[size_]),
+		rotation_( 0)
+	{}
+
+	bool active() const
+	{ return active_(); }
+
+	// waits for pushes which saw the queue active
+	void deactivate()
+	{
+		state_.store( DEACTIVE);
+		for ( std::size_t i = 0; i < size_; ++i)
+			while ( 0 != shards_[i].producers.load( memory_order_acquire) )
+				this_thread::yield();
+	}
+
+	bool empty() const
+	{
+		for ( std::size_t i = 0; i < size_; ++i)
+			if ( 0 != shards_[i].size() ) return false;
+		return true;
+	}
+
+	std::size_t shards() const
+	{ return size_; }
+
+	void put( value_type const& va)
+	{
+		if ( ! push_( va) )
+			BOOST_THROW_EXCEPTION( task_rejected("queue is not active") );
+	}
+
+	bool try_put( value_type const& va)
+	{ return push_( va); }
+
+	bool try_take( value_type & va)
+	{ return 1 == try_take_n( & va, 1, 1); }
+
+	// drains up to n items from the home shard; if it is empty, up to
+	// half of another shard is taken - parts is ignored because every
+	// consumer owns a shard
+	std::size_t try_take_n( value_type * va, std::size_t n, std::size_t)
+	{
+		std::size_t home( home_() );
+		std::size_t start( start_( home) );
+		for ( std::size_t j = 0; j < size_; ++j)
+		{
+			std::size_t idx( ( start + j) % size_);
+			shard & s( shards_[idx]);
+			std::size_t size( s.size() );
+			if ( 0 == size || ! s.try_lock() ) continue;
+			std::size_t i( take_(
+				s, va,
+				home == idx ? n : ( std::min)( n, ( std::max)( std::size_t( 1), size / 2) ) ) );
+			s.unlock();
+			if ( 0 < i) return i;
+		}
+		return 0;
+	}
+
+    friend
+    inline void intrusive_ptr_add_ref( sharded_fifo_base< T > * p)
+    { p->use_count_.fetch_add( 1, memory_order_relaxed); }
+
+    friend
+    inline void intrusive_ptr_release( sharded_fifo_base< T > * p)
+    {
+        if ( p->use_count_.fetch_sub( 1, memory_order_release) == 1)
+        {
+            atomic_thread_fence( memory_order_acquire);
+            delete p;
+        }
+    }
+};
+
+}
+
+template< typename T >
+class sharded_fifo
+{
+private:
+    typedef sharded_fifo< T >   queue_type;
+
+    intrusive_ptr< detail::sharded_fifo_base< T > >   impl_;
+
+    BOOST_MOVABLE_BUT_NOT_COPYABLE( sharded_fifo);
+
+public:
+	typedef typename detail::sharded_fifo_base< T >::attribute_tag_type	attribute_tag_type;
+	typedef typename detail::sharded_fifo_base< T >::value_type			value_type;
+    typedef void ( * unspecified_bool_type)( sharded_fifo< T > ***);
+
+    static void unspecified_bool( sharded_fifo< T > ***) {}
+
+	sharded_fifo() :
+		impl_( new detail::sharded_fifo_base< T >() )
+	{}
+
+	explicit sharded_fifo( std::size_t shards) :
+		impl_( new detail::sharded_fifo_base< T >( shards) )
+	{}
+
+    sharded_fifo( BOOST_RV_REF( queue_type) other) :
+       impl_()
+    { swap( other); } 
+
+    sharded_fifo & operator=( BOOST_RV_REF( queue_type) other)
+    {
+        if ( this == other) return * this;
+        sharded_fifo tmp( boost::move( other) );
+        swap( tmp);
+        return * this;
+    }
+
+    operator unspecified_bool_type() const
+    { return impl_ ? unspecified_bool : 0; }
+
+    bool operator!() const
+    { return ! impl_; }
+
+    void swap( sharded_fifo & other)
+    { impl_.swap( other.impl_); }
+
+	bool active() const
+	{
+        BOOST_ASSERT( impl_);
+        return impl_->active();
+    }
+
+	void deactivate()
+	{
+        BOOST_ASSERT( impl_);
+        impl_->deactivate();
+	}
+
+	bool empty() const
+	{
+        BOOST_ASSERT( impl_);
+		return impl_->empty();
+	}
+
+	std::size_t shards() const
+	{
+        BOOST_ASSERT( impl_);
+		return impl_->shards();
+	}
+
+	void put( value_type const& va)
+	{
+        BOOST_ASSERT( impl_);
+        impl_->put( va);
+	}
+
+	bool try_put( value_type const& va)
+	{
+        BOOST_ASSERT( impl_);
+        return impl_->try_put( va);
+	}
+
+	bool try_take( value_type & va)
+	{
+        BOOST_ASSERT( impl_);
+		return impl_->try_take( va);
+	}
+
+	std::size_t try_take_n( value_type * va, std::size_t n, std::size_t parts = 1)
+	{
+        BOOST_ASSERT( impl_);
+		return impl_->try_take_n( va, n, parts);
+	}
+};
+
+template< typename T >
+void swap( sharded_fifo< T > & l, sharded_fifo< T > & r)
+{ l.swap( r); }
+
+}}
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_SUFFIX
+#endif
+
+#endif // BOOST_TASKS_SHARDED_FIFO_H
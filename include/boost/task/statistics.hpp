@@ -0,0 +1,90 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_TASKS_STATISTICS_H
+#define BOOST_TASKS_STATISTICS_H
+
+#include <cstddef>
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_PREFIX
+#endif
+
+namespace boost {
+namespace tasks {
+
+// counters accumulated over all worker-threads of a pool
+struct statistics
+{
+	// worker-queues of other worker-threads probed for work
+	std::size_t	steal_attempts;
+	// probes which returned work
+	std::size_t	steals;
+	// work items taken by successful probes
+	std::size_t	stolen;
+	// successful probes of a worker-thread running on another NUMA node
+	std::size_t	remote_steals;
+	// fiber stacks mapped from the operating system - the others were
+	// recycled from the stack caches
+	std::size_t	stacks_mapped;
+	// work-items which started on the stack of a scheduler (lazy fibers)
+	// and were moved to a fiber because they suspended
+	std::size_t	promotions;
+	// work-items executed by worker-threads while a task waited
+	// for another one
+	std::size_t	helped;
+	// dequeue operations on the global queue which returned work
+	std::size_t	global_takes;
+	// work-items taken from the global queue - a dequeue operation
+	// moves a batch into the worker-queue
+	std::size_t	global_taken;
+	// fairness-ticks - the global queue, suspended work-items and other
+	// worker-queues were polled before the local worker-queue
+	std::size_t	ticks;
+	// tasks spawned while the worker-queue was full - moved to the
+	// global queue or executed inline by the spawning task
+	std::size_t	spilled;
+	std::size_t	inlined;
+	// tasks submitted with an affinity hint and taken by the chosen
+	// worker-thread or - after affinity_delay - by another one
+	std::size_t	posted;
+	std::size_t	posted_stolen;
+	// microseconds of CPU time idle worker-threads spent spinning or
+	// yielding and the number of times they parked (see idle_strategy)
+	std::size_t	spin_time;
+	std::size_t	parks;
+	// worker-threads which could not be bound to the CPU of the
+	// processor set of the pool - they run unbound
+	std::size_t	bind_failures;
+
+	statistics() :
+		steal_attempts( 0),
+		steals( 0),
+		stolen( 0),
+		remote_steals( 0),
+		stacks_mapped( 0),
+		promotions( 0),
+		helped( 0),
+		global_takes( 0),
+		global_taken( 0),
+		ticks( 0),
+		spilled( 0),
+		inlined( 0),
+		posted( 0),
+		posted_stolen( 0),
+		spin_time( 0),
+		parks( 0),
+		bind_failures( 0)
+	{}
+};
+
+}}
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_SUFFIX
+#endif
+
+#endif // BOOST_TASKS_STATISTICS_H
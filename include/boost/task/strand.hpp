@@ -0,0 +1,191 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_TASKS_STRAND_H
+#define BOOST_TASKS_STRAND_H
+
+#include <cstddef>
+
+#include <boost/config.hpp>
+#include <boost/functional/hash.hpp>
+#include <boost/intrusive_ptr.hpp>
+#include <boost/move/move.hpp>
+#include <boost/result_of.hpp>
+#include <boost/thread/future.hpp>
+
+#include <boost/task/affinity.hpp>
+#include <boost/task/callable.hpp>
+#include <boost/task/context.hpp>
+#include <boost/task/detail/strand_queue.hpp>
+#include <boost/task/exceptions.hpp>
+#include <boost/task/spin/future.hpp>
+#include <boost/task/task.hpp>
+#include <boost/task/utility.hpp>
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_PREFIX
+#endif
+
+namespace boost {
+namespace tasks {
+namespace detail {
+
+// submitted to the pool if a task is posted to an idle strand - executes
+// the queued tasks of the strand and resubmits itself if tasks are left
+template< typename Pool >
+class strand_runner
+{
+private:
+	// tasks executed before the strand goes back to the pool
+	static const std::size_t	batch = 16;
+
+	Pool						*	pool_;
+	intrusive_ptr< strand_array >	strands_;
+	std::size_t						idx_;
+	bool							hinted_;
+
+public:
+	typedef void	result_type;
+
+	strand_runner(
+			Pool & pool,
+			intrusive_ptr< strand_array > const& strands,
+			std::size_t idx,
+			bool hinted) :
+		pool_( & pool), strands_( strands), idx_( idx), hinted_( hinted)
+	{}
+
+	void operator()() const
+	{ if ( ( * strands_)[idx_].run( batch) ) schedule(); }
+
+	// a keyed strand always runs on the same worker-thread unless
+	// it is busy (see affinity)
+	// if the pool rejects the strand (closed) nobody would execute
+	// its tasks - they are dropped so that the strand can be
+	// scheduled again and waiting threads are not blocked forever
+	void schedule() const
+	{
+		try
+		{
+			if ( hinted_)
+				pool_->submit( * this, affinity( idx_) );
+			else
+				pool_->submit( * this);
+		}
+		catch (...)
+		{
+			( * strands_)[idx_].discard();
+			throw;
+		}
+	}
+};
+
+// a task of a strand gets the context of a task submitted to the pool,
+// none if the pool does not support interruption
+template< typename Pool >
+context strand_context()
+{ return Pool::policy_type::interruption ? context() : context::none(); }
+
+template< typename Pool, typename Fn >
+task< typename result_of< Fn() >::result_type > strand_submit(
+		Pool & pool,
+		intrusive_ptr< strand_array > const& strands,
+		std::size_t idx,
+		bool hinted,
+		Fn fn)
+{
+	typedef typename result_of< Fn() >::result_type R;
+
+	if ( pool.closed() )
+		throw task_rejected("pool is closed");
+
+	// the task does not reference the callable - a waiting thread
+	// must not execute it out of order (see task< R >::try_run())
+	if ( this_task::runs_in_pool() )
+	{
+		detail::promise< R > prom;
+		detail::shared_future< R > f( prom.get_future() );
+		context ctx( strand_context< Pool >() );
+		callable ca( fn, boost::move( prom), ctx);
+		task< R > t( f, ctx);
+		if ( ( * strands)[idx].push( ca) )
+			strand_runner< Pool >( pool, strands, idx, hinted).schedule();
+		return t;
+	}
+	else
+	{
+		promise< R > prom;
+		shared_future< R > f( prom.get_future() );
+		context ctx( strand_context< Pool >() );
+		callable ca( fn, boost::move( prom), ctx);
+		task< R > t( f, ctx);
+		if ( ( * strands)[idx].push( ca) )
+			strand_runner< Pool >( pool, strands, idx, hinted).schedule();
+		return t;
+	}
+}
+
+}
+
+// tasks submitted to a strand are executed one at a time in FIFO order,
+// tasks of different strands in parallel - no worker-thread blocks on
+// a strand, an idle strand costs no thread
+// the pool must outlive the strand and its tasks
+template< typename Pool >
+class strand
+{
+private:
+	Pool									*	pool_;
+	intrusive_ptr< detail::strand_array >		strands_;
+
+public:
+	explicit strand( Pool & pool) :
+		pool_( & pool),
+		strands_( new detail::strand_array( 1) )
+	{}
+
+	template< typename Fn >
+	task< typename result_of< Fn() >::result_type > submit( Fn fn)
+	{ return detail::strand_submit( * pool_, strands_, 0, false, fn); }
+};
+
+// a strand per key - keys are hashed to a fixed number of strands, keys
+// sharing a strand are serialized too
+// the strand of a key is executed by the same worker-thread as long as
+// it is not busy
+template< typename Pool, typename Key = std::size_t, typename Hash = hash< Key > >
+class keyed_strand
+{
+private:
+	Pool									*	pool_;
+	intrusive_ptr< detail::strand_array >		strands_;
+	Hash										hash_;
+
+public:
+	keyed_strand( Pool & pool, std::size_t size, Hash const& hash = Hash() ) :
+		pool_( & pool),
+		strands_( new detail::strand_array( size) ),
+		hash_( hash)
+	{ if ( 0 == size) throw invalid_strand_count(); }
+
+	std::size_t size() const
+	{ return strands_->size(); }
+
+	template< typename Fn >
+	task< typename result_of< Fn() >::result_type > submit( Key const& key, Fn fn)
+	{
+		return detail::strand_submit(
+			* pool_, strands_, hash_( key) % strands_->size(), true, fn);
+	}
+};
+
+}}
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_SUFFIX
+#endif
+
+#endif // BOOST_TASKS_STRAND_H
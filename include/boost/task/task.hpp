@@ -20,6 +20,7 @@
 #include <boost/task/detail/future.hpp>
 #include <boost/task/detail/task_base.hpp>
 #include <boost/task/detail/task_object.hpp>
+#include <boost/task/detail/worker.hpp>
 
 #ifdef BOOST_HAS_ABI_HEADERS
 #  include BOOST_ABI_PREFIX
@@ -36,16 +37,27 @@ private:
 
     BOOST_MOVABLE_BUT_NOT_COPYABLE( task);
 
-	task( detail::unique_future< R > const& fut, context const& ctx)
+	// a worker-thread waiting for the task executes it if it is still
+	// queued (in a pool with stealing), otherwise the work-items of its
+	// worker-queue in the meantime
+	void help_() const
+	{
+		detail::worker * w( detail::worker::instance() );
+		if ( w && ! impl_->is_ready() ) w->help( * impl_);
+	}
+
+	task( detail::unique_future< R > const& fut, context const& ctx,
+		  callable const& ca = callable() )
         impl_(
             new detail::task_object< R, detail::unique_future< R >(
-                boost::move( fut), ctx) )
+                boost::move( fut), ctx, ca) )
 	{}
 
-	task( unique_future< R > const& fut, context const& ctx)
+	task( unique_future< R > const& fut, context const& ctx,
+		  callable const& ca = callable() )
         impl_(
             new detail::task_object< R, unique_future< R >(
-                boost::move( fut), ctx) )
+                boost::move( fut), ctx, ca) )
 	{}
 
 public:
@@ -116,6 +128,7 @@ public:
 	void wait()
 	{
         BOOST_ASSERT( impl_);
+		help_();
 		impl_->wait();
 	}
 
@@ -125,9 +138,24 @@ public:
 		return impl_->wait_until( abs_time);
 	}
 
+	// executes the task on the calling thread if it was not started by
+	// a worker-thread yet - returns false if it was already started
+	bool try_run()
+	{
+        BOOST_ASSERT( impl_);
+		return impl_->try_run();
+	}
+
     template< typename TimeDuration >
 	bool wait_for( TimeDuration const& dt)
 	{ return wait_until( get_system_time() + dt); }
+
+	R get()
+	{
+        BOOST_ASSERT( impl_);
+		help_();
+		return impl_->get();
+	}
 };
 
 inline
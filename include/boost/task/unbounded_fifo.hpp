@@ -7,6 +7,7 @@
 #ifndef BOOST_TASKS_UNBOUNDED_FIFO_H
 #define BOOST_TASKS_UNBOUNDED_FIFO_H
 
+#include <algorithm>
 #include <cstddef>
 
 #include <boost/assert.hpp>
@@ -68,6 +69,7 @@ private:
 
     std::size_t         use_count_;
 	atomic< state >		state_;
+	atomic< std::size_t >	count_;
 	node::sptr_t		head_;
 	mutable mutex		head_mtx_;
 	node::sptr_t		tail_;
@@ -80,6 +82,9 @@ private:
 	void deactivate_()
 	{ state_.store( DEACTIVE); }
 
+	std::size_t size_() const
+	{ return count_.load(); }
+
 	bool empty_() const
 	{ return head_ == get_tail_(); }
 
@@ -94,6 +99,7 @@ private:
 	{
 		node::sptr_t old_head = head_;
 		head_ = old_head->next;
+		count_.fetch_sub( 1);
 		return old_head;
 	}
 
@@ -101,6 +107,7 @@ public:
 	unbounded_fifo_base() :
         use_count_( 0),
 		state_( ACTIVE),
+		count_( 0),
 		head_( new node),
 		head_mtx_(),
 		tail_( head_),
@@ -111,6 +118,7 @@ public:
 	unbounded_fifo_base( fast_semaphore & fsem) :
         use_count_( 0),
 		state_( ACTIVE),
+		count_( 0),
 		head_( new node),
 		head_mtx_(),
 		tail_( head_),
@@ -143,10 +151,27 @@ public:
 			tail_->va = va;
 			tail_->next = new_node;
 			tail_ = new_node;
+			count_.fetch_add( 1);
 		}
 		if( fsem_) fsem_->post();
 	}
 
+	// never blocks - returns false if the queue is not active
+	bool try_put( value_type const& va)
+	{
+		node::sptr_t new_node( new node);
+		{
+			unique_lock< mutex > lk( tail_mtx_);
+			if ( ! active_() ) return false;
+			tail_->va = va;
+			tail_->next = new_node;
+			tail_ = new_node;
+			count_.fetch_add( 1);
+		}
+		if( fsem_) fsem_->post();
+		return true;
+	}
+
 	bool try_take( value_type & va)
 	{
 		unique_lock< mutex > lk( head_mtx_);
@@ -157,6 +182,24 @@ public:
 		return ! va.empty();
 	}
 
+	// takes up to n items, but not more than the share of one of
+	// parts consumers, with one lock acquisition
+	std::size_t try_take_n( value_type * va, std::size_t n, std::size_t parts)
+	{
+		unique_lock< mutex > lk( head_mtx_);
+		// items counted are linked - count_ is incremented after
+		std::size_t size( size_() );
+		n = ( std::min)( n, ( std::min)( size, ( std::max)( std::size_t( 1), size / parts) ) );
+		std::size_t i = 0;
+		while ( 0 < n--)
+		{
+			va[i].swap( head_->va);
+			pop_head_();
+			if ( ! va[i].empty() ) ++i;
+		}
+		return i;
+	}
+
     friend
     inline void intrusive_ptr_add_ref( unbounded_fifo_base< T > * p)
     { p->use_count_.fetch_add( 1, memory_order_relaxed); }
@@ -253,11 +296,23 @@ public:
         impl_->put( va, rel_time);
 	}
 
+	bool try_put( value_type const& va)
+	{
+        BOOST_ASSERT( impl_);
+        return impl_->try_put( va);
+	}
+
 	bool try_take( value_type & va)
 	{
         BOOST_ASSERT( impl_);
 		return impl_->try_take( va);
 	}
+
+	std::size_t try_take_n( value_type * va, std::size_t n, std::size_t parts = 1)
+	{
+        BOOST_ASSERT( impl_);
+		return impl_->try_take_n( va, n, parts);
+	}
 };
 
 template< typename T >
@@ -89,7 +89,7 @@ private:
 	atomic< state >			state_;
 	queue_type				queue_;
 	mutable shared_mutex	mtx_;
-	fast_semaphore		&	fsem_;
+	fast_semaphore		*	fsem_;
 
 	bool active_() const
 	{ return ACTIVE == state_.load(); }
@@ -105,7 +105,7 @@ private:
 		if ( ! active_() )
 			BOOST_THROW_EXCEPTION( task_rejected("queue is not active") );
 		queue_.push( va);
-		fsem_.post();
+		if ( fsem_) fsem_->post();
 	}
 
 	bool try_take_( T & ca)
@@ -118,12 +118,34 @@ private:
 		return ! ca.empty();
 	}
 
+	std::size_t try_take_n_( T * ca, std::size_t n, std::size_t parts)
+	{
+		std::size_t size( queue_.size() );
+		n = ( std::min)( n, ( std::min)( size, ( std::max)( std::size_t( 1), size / parts) ) );
+		std::size_t i = 0;
+		while ( 0 < n--)
+		{
+			T tmp( queue_.top().ca);
+			queue_.pop();
+			ca[i].swap( tmp);
+			if ( ! ca[i].empty() ) ++i;
+		}
+		return i;
+	}
+
 public:
+	unbounded_prio_queue_base() :
+		state_( ACTIVE),
+		queue_(),
+		mtx_(),
+		fsem_( 0)
+	{}
+
 	unbounded_prio_queue_base( fast_semaphore & fsem) :
 		state_( ACTIVE),
 		queue_(),
 		mtx_(),
-		fsem_( fsem)
+		fsem_( & fsem)
 	{}
 
 	bool active() const
@@ -152,6 +174,30 @@ public:
 		unique_lock< shared_mutex > lk( mtx_);
 		return try_take_( ca);
 	}
+
+	// takes the item with the highest priority only if its attribute
+	// is at or above min_attr
+	bool try_take( T & ca, attribute_type const& min_attr)
+	{
+		unique_lock< shared_mutex > lk( mtx_);
+		if ( empty_() || Comp()( queue_.top().attr, min_attr) ) return false;
+		return try_take_( ca);
+	}
+
+	// true if no item at or above min_attr is queued
+	bool empty( attribute_type const& min_attr) const
+	{
+		shared_lock< shared_mutex > lk( mtx_);
+		return empty_() || Comp()( queue_.top().attr, min_attr);
+	}
+
+	// takes up to n items in priority order, but not more than the
+	// share of one of parts consumers, with one lock acquisition
+	std::size_t try_take_n( T * ca, std::size_t n, std::size_t parts)
+	{
+		unique_lock< shared_mutex > lk( mtx_);
+		return try_take_n_( ca, n, parts);
+	}
 };
 
 }
@@ -173,12 +219,13 @@ private:
 public:
 	typedef typename detail::unbounded_prio_queue_base< T >::attribute_tag_type	attribute_tag_type;
 	typedef typename detail::unbounded_prio_queue_base< T >::value_type			value_type;
+	typedef Attr	attribute_type;
     typedef void ( * unspecified_bool_type)( unbounded_prio_queue< T > ***);
 
     static void unspecified_bool( unbounded_prio_queue< T > ***) {}
 
-	unbounded_prio_queue_base() :
-		impl_( new detail::unbounded_prio_queue_base< T >() )
+	unbounded_prio_queue() :
+		impl_( new detail::unbounded_prio_queue_base< T, Attr, Comp >() )
 	{}
 
 	unbounded_prio_queue( fast_semaphore & fsem) :
@@ -235,6 +282,28 @@ public:
 		BOOST_ASSERT( impl_);
 		return impl_->try_take( ca);
 	}
+
+	bool try_take( T & ca, attribute_type const& min_attr)
+	{
+		BOOST_ASSERT( impl_);
+		return impl_->try_take( ca, min_attr);
+	}
+
+	bool empty( attribute_type const& min_attr) const
+	{
+		BOOST_ASSERT( impl_);
+		return impl_->empty( min_attr);
+	}
+
+	// true if attr is at or above min_attr
+	static bool at_least( attribute_type const& attr, attribute_type const& min_attr)
+	{ return ! Comp()( attr, min_attr); }
+
+	std::size_t try_take_n( T * ca, std::size_t n, std::size_t parts = 1)
+	{
+		BOOST_ASSERT( impl_);
+		return impl_->try_take_n( ca, n, parts);
+	}
 };
 
 template< typename T, typename Attr, typename Comp >
@@ -24,7 +24,7 @@ bool runs_in_pool()
 { return tasks::detail::worker::instance() != 0; }
 
 inline
-worker::id worker_id()
+tasks::detail::worker::id worker_id()
 {
 	BOOST_ASSERT( runs_in_pool() );
 
@@ -36,7 +36,7 @@ void yield()
 {
 	BOOST_ASSERT( runs_in_pool() );
 
-	tasks::detail::worker::instance()->yield();
+	tasks::detail::worker::active()->yield();
 }
 
 }}
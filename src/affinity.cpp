@@ -0,0 +1,19 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include "boost/task/affinity.hpp"
+
+namespace boost {
+namespace tasks {
+
+affinity::affinity( std::size_t index) :
+	value_( index)
+{}
+
+affinity::operator std::size_t () const
+{ return value_; }
+
+}}
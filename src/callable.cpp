@@ -6,6 +6,9 @@
 
 #include "boost/task/callable.hpp"
 
+#include <algorithm>
+#include <new>
+
 namespace boost {
 namespace tasks {
 
@@ -13,9 +16,25 @@ callable::callable() :
 	base_()
 {}
 
+callable::callable( detail::callable_base * base) :
+	base_( base, false)
+{}
+
 void
 callable::operator()()
-{ base_->run(); }
+{ try_run(); }
+
+bool
+callable::try_run()
+{
+	if ( ! base_->claim() ) return false;
+	base_->run();
+	return true;
+}
+
+bool
+callable::claimed() const
+{ return base_->claimed.load( memory_order_acquire); }
 
 bool
 callable::empty() const
@@ -33,4 +52,58 @@ void
 callable::swap( callable & other)
 { base_.swap( other.base_); }
 
+detail::callable_base *
+callable::release()
+{
+	detail::callable_base * base( base_.get() );
+	// the reference is handed over - base_ forgets the pointer
+	// without decrementing the reference count
+	new ( & base_) intrusive_ptr< detail::callable_base >();
+	return base;
+}
+
+namespace detail {
+
+callable_token::callable_token() :
+	base_( 0)
+{}
+
+callable_token::callable_token( callable const& ca) :
+	base_( ca.base_.get() )
+{ if ( base_) weak_add_ref( base_); }
+
+callable_token::callable_token( callable_token const& other) :
+	base_( other.base_)
+{ if ( base_) weak_add_ref( base_); }
+
+callable_token::~callable_token()
+{ if ( base_) weak_release( base_); }
+
+callable_token &
+callable_token::operator=( callable_token const& other)
+{
+	callable_token tmp( other);
+	swap( tmp);
+	return * this;
+}
+
+bool
+callable_token::try_run()
+{
+	if ( ! base_ || ! base_->lock() ) return false;
+	// adopts the reference taken by lock()
+	callable ca( base_);
+	return ca.try_run();
+}
+
+bool
+callable_token::empty() const
+{ return ! base_; }
+
+void
+callable_token::swap( callable_token & other)
+{ std::swap( base_, other.base_); }
+
+}
+
 }}
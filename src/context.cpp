@@ -64,17 +64,25 @@ context::context() :
 	base_( new detail::context_base() )
 {}
 
+context::context( detail::context_base::ptr_t const& base) :
+	base_( base)
+{}
+
+context
+context::none()
+{ return context( detail::context_base::ptr_t() ); }
+
 void
 context::reset( shared_ptr< thread > const& thrd)
-{ base_->reset( thrd); }
+{ if ( base_) base_->reset( thrd); }
 
 void
 context::interrupt()
-{ base_->interrupt(); }
+{ if ( base_) base_->interrupt(); }
 
 bool
 context::interruption_requested()
-{ return base_->interruption_requested(); }
+{ return base_ && base_->interruption_requested(); }
 
 void
 context::swap( context & other)
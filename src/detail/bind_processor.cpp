@@ -0,0 +1,64 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include "boost/task/detail/bind_processor.hpp"
+
+#if defined(BOOST_HAS_PROCESSOR_BINDINGS)
+
+extern "C"
+{
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+}
+
+#include <boost/assert.hpp>
+
+namespace boost {
+namespace tasks {
+namespace detail {
+
+std::vector< int >
+allowed_processors()
+{
+	// the kernel rejects a mask smaller than its own CPU mask -
+	// the mask grows until it is large enough
+	std::vector< int > cpus;
+	for ( int n = CPU_SETSIZE; ; n *= 2)
+	{
+		cpu_set_t * set( CPU_ALLOC( n) );
+		if ( ! set) return cpus;
+		std::size_t size( CPU_ALLOC_SIZE( n) );
+		CPU_ZERO_S( size, set);
+		if ( 0 == ::sched_getaffinity( 0, size, set) )
+		{
+			for ( int cpu = 0; cpu < n; ++cpu)
+				if ( CPU_ISSET_S( cpu, size, set) ) cpus.push_back( cpu);
+			CPU_FREE( set);
+			return cpus;
+		}
+		CPU_FREE( set);
+		if ( EINVAL != errno) return cpus;
+	}
+}
+
+bool
+bind_to_processor( int cpu)
+{
+	BOOST_ASSERT( 0 <= cpu);
+	cpu_set_t * set( CPU_ALLOC( cpu + 1) );
+	if ( ! set) return false;
+	std::size_t size( CPU_ALLOC_SIZE( cpu + 1) );
+	CPU_ZERO_S( size, set);
+	CPU_SET_S( cpu, size, set);
+	int result( ::pthread_setaffinity_np( ::pthread_self(), size, set) );
+	CPU_FREE( set);
+	return 0 == result;
+}
+
+}}}
+
+#endif
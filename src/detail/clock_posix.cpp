@@ -0,0 +1,33 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include "boost/task/detail/clock.hpp"
+
+extern "C" {
+#include <time.h>
+}
+
+namespace boost {
+namespace tasks {
+namespace detail {
+
+boost::int64_t
+monotonic_now()
+{
+	timespec ts;
+	::clock_gettime( CLOCK_MONOTONIC, & ts);
+	return static_cast< boost::int64_t >( ts.tv_sec) * 1000000 + ts.tv_nsec / 1000;
+}
+
+boost::int64_t
+thread_cpu_now()
+{
+	timespec ts;
+	::clock_gettime( CLOCK_THREAD_CPUTIME_ID, & ts);
+	return static_cast< boost::int64_t >( ts.tv_sec) * 1000000 + ts.tv_nsec / 1000;
+}
+
+}}}
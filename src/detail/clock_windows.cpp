@@ -0,0 +1,49 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include "boost/task/detail/clock.hpp"
+
+extern "C" {
+#include <windows.h>
+}
+
+namespace {
+
+boost::int64_t frequency()
+{
+	LARGE_INTEGER f;
+	::QueryPerformanceFrequency( & f);
+	return f.QuadPart;
+}
+
+}
+
+namespace boost {
+namespace tasks {
+namespace detail {
+
+boost::int64_t
+monotonic_now()
+{
+	static const boost::int64_t freq( frequency() );
+	LARGE_INTEGER c;
+	::QueryPerformanceCounter( & c);
+	// split to avoid the overflow of counter * 1000000
+	return ( c.QuadPart / freq) * 1000000 + ( c.QuadPart % freq) * 1000000 / freq;
+}
+
+boost::int64_t
+thread_cpu_now()
+{
+	FILETIME creation, exit, kernel, user;
+	::GetThreadTimes( ::GetCurrentThread(), & creation, & exit, & kernel, & user);
+	// 100 nanosecond units
+	boost::int64_t k( ( static_cast< boost::int64_t >( kernel.dwHighDateTime) << 32) | kernel.dwLowDateTime);
+	boost::int64_t u( ( static_cast< boost::int64_t >( user.dwHighDateTime) << 32) | user.dwLowDateTime);
+	return ( k + u) / 10;
+}
+
+}}}
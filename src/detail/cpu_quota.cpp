@@ -0,0 +1,170 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include "boost/task/detail/cpu_quota.hpp"
+
+#include <cstdlib>
+#include <fstream>
+#include <istream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <boost/thread/thread.hpp>
+
+#include <boost/task/detail/bind_processor.hpp>
+
+namespace {
+
+std::vector< std::string > split( std::string const& str, char sep)
+{
+	std::vector< std::string > items;
+	std::istringstream is( str);
+	std::string item;
+	while ( std::getline( is, item, sep) )
+		items.push_back( item);
+	return items;
+}
+
+bool contains( std::string const& list, std::string const& item)
+{
+	std::vector< std::string > items( split( list, ',') );
+	for ( std::vector< std::string >::iterator i = items.begin(); i != items.end(); ++i)
+		if ( item == * i) return true;
+	return false;
+}
+
+#if defined(__linux__)
+
+bool read_line( std::string const& path, std::string & line)
+{
+	std::ifstream in( path.c_str() );
+	return in && std::getline( in, line);
+}
+
+// quota of one cgroup in CPUs, 0 if unlimited
+double quota_of( bool v2, std::string const& dir)
+{
+	std::string line;
+	if ( v2)
+	{
+		if ( ! read_line( dir + "/cpu.max", line) ) return 0;
+		return boost::tasks::detail::cpu_max_quota( line);
+	}
+	std::string period;
+	if ( ! read_line( dir + "/cpu.cfs_quota_us", line) ) return 0;
+	if ( ! read_line( dir + "/cpu.cfs_period_us", period) ) return 0;
+	return boost::tasks::detail::cfs_quota( line, period);
+}
+
+// the smallest quota of the cgroup and its parents
+double hierarchy_quota( bool v2)
+{
+	std::ifstream mountinfo( "/proc/self/mountinfo");
+	std::ifstream cgroup( "/proc/self/cgroup");
+	std::string dir, mount_point;
+	if ( ! boost::tasks::detail::cgroup_dir( v2, mountinfo, cgroup, dir, mount_point) )
+		return 0;
+	double quota( 0);
+	for (;;)
+	{
+		double q( quota_of( v2, dir) );
+		if ( 0 < q && ( 0 == quota || q < quota) ) quota = q;
+		if ( dir.size() <= mount_point.size() ) break;
+		dir = dir.substr( 0, dir.rfind( '/') );
+	}
+	return quota;
+}
+
+#endif
+
+}
+
+namespace boost {
+namespace tasks {
+namespace detail {
+
+double
+cpu_quota()
+{
+#if defined(__linux__)
+	double quota( hierarchy_quota( true) );
+	return 0 < quota ? quota : hierarchy_quota( false);
+#else
+	return 0;
+#endif
+}
+
+std::size_t
+cpu_affinity()
+{
+#if defined(BOOST_HAS_PROCESSOR_BINDINGS)
+	std::size_t n( allowed_processors().size() );
+	if ( 0 < n) return n;
+#endif
+	return thread::hardware_concurrency();
+}
+
+bool
+cgroup_dir(
+	bool v2, std::istream & mountinfo, std::istream & cgroup,
+	std::string & dir, std::string & mount_point)
+{
+	// mountinfo: "36 35 0:30 <root> <mount point> <options> ... - <fstype> <source> <super options>"
+	std::string line, root;
+	bool mounted( false);
+	while ( ! mounted && std::getline( mountinfo, line) )
+	{
+		std::string::size_type sep( line.find( " - ") );
+		if ( std::string::npos == sep) continue;
+		std::vector< std::string > fields( split( line.substr( 0, sep), ' ') );
+		std::vector< std::string > fs( split( line.substr( sep + 3), ' ') );
+		if ( 5 > fields.size() || 3 > fs.size() ) continue;
+		if ( v2 ? "cgroup2" != fs[0] : ( "cgroup" != fs[0] || ! contains( fs[2], "cpu") ) ) continue;
+		root = fields[3];
+		mount_point = fields[4];
+		mounted = true;
+	}
+	if ( ! mounted) return false;
+
+	// cgroup: "<id>:<controllers>:<path>", v2 has id 0 and no controllers
+	while ( std::getline( cgroup, line) )
+	{
+		std::string::size_type first( line.find( ':') );
+		std::string::size_type second( line.find( ':', first + 1) );
+		if ( std::string::npos == first || std::string::npos == second) continue;
+		std::string controllers( line.substr( first + 1, second - first - 1) );
+		if ( v2 ? ! controllers.empty() : ! contains( controllers, "cpu") ) continue;
+		std::string path( line.substr( second + 1) );
+		// the mount shows a sub-tree of the hierarchy (cgroup namespace)
+		if ( "/" != root && 0 == path.compare( 0, root.size(), root) &&
+			 ( path.size() == root.size() || '/' == path[root.size()]) )
+			path = path.substr( root.size() );
+		dir = path.empty() || "/" == path ? mount_point : mount_point + path;
+		return true;
+	}
+	return false;
+}
+
+double
+cpu_max_quota( std::string const& line)
+{
+	std::vector< std::string > fields( split( line, ' ') );
+	if ( 2 != fields.size() || "max" == fields[0]) return 0;
+	double quota( std::atof( fields[0].c_str() ) );
+	double period( std::atof( fields[1].c_str() ) );
+	return 0 < quota && 0 < period ? quota / period : 0;
+}
+
+double
+cfs_quota( std::string const& quota_us, std::string const& period_us)
+{
+	double quota( std::atof( quota_us.c_str() ) );
+	double period( std::atof( period_us.c_str() ) );
+	return 0 < quota && 0 < period ? quota / period : 0;
+}
+
+}}}
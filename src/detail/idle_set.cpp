@@ -0,0 +1,105 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include "boost/task/detail/idle_set.hpp"
+
+#include <boost/assert.hpp>
+
+namespace {
+
+inline
+std::size_t lowest_bit( boost::uint64_t w)
+{
+	BOOST_ASSERT( 0 != w);
+#if defined(__GNUC__)
+	return static_cast< std::size_t >( __builtin_ctzll( w) );
+#else
+	std::size_t n = 0;
+	while ( 0 == ( w & 1) ) { w >>= 1; ++n; }
+	return n;
+#endif
+}
+
+}
+
+namespace boost {
+namespace tasks {
+namespace detail {
+
+idle_set::idle_set( std::size_t size) :
+	size_( size),
+	words_( ( size + bits - 1) / bits),
+	mask_( new atomic< word_t >[words_]),
+	hint_( 0),
+	searching_( 0)
+{
+	for ( std::size_t i = 0; i < words_; ++i)
+		mask_[i].store( 0, memory_order_relaxed);
+}
+
+void
+idle_set::add( std::size_t idx)
+{
+	BOOST_ASSERT( idx < size_);
+	mask_[idx / bits].fetch_or( word_t( 1) << ( idx % bits), memory_order_seq_cst);
+}
+
+bool
+idle_set::remove( std::size_t idx)
+{
+	BOOST_ASSERT( idx < size_);
+	word_t bit = word_t( 1) << ( idx % bits);
+	return 0 != ( mask_[idx / bits].fetch_and( ~bit, memory_order_seq_cst) & bit);
+}
+
+bool
+idle_set::claim( std::size_t & idx)
+{
+	// start at a rotating word so that wake-ups are spread
+	std::size_t start = hint_.load( memory_order_relaxed);
+	for ( std::size_t j = 0; j < words_; ++j)
+	{
+		std::size_t i = ( start + j) % words_;
+		word_t w = mask_[i].load( memory_order_seq_cst);
+		while ( 0 != w)
+		{
+			std::size_t b = lowest_bit( w);
+			if ( mask_[i].compare_exchange_weak(
+					w, w & ~( word_t( 1) << b), memory_order_seq_cst) )
+			{
+				hint_.store( i, memory_order_relaxed);
+				idx = i * bits + b;
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+bool
+idle_set::empty() const
+{
+	for ( std::size_t i = 0; i < words_; ++i)
+		if ( 0 != mask_[i].load( memory_order_seq_cst) ) return false;
+	return true;
+}
+
+bool
+idle_set::begin_search()
+{
+	unsigned int expected = 0;
+	return searching_.compare_exchange_strong( expected, 1, memory_order_seq_cst);
+}
+
+bool
+idle_set::end_search()
+{ return 1 == searching_.fetch_sub( 1, memory_order_seq_cst); }
+
+unsigned int
+idle_set::searching() const
+{ return searching_.load( memory_order_seq_cst); }
+
+}}}
@@ -0,0 +1,82 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include "boost/task/detail/inbox.hpp"
+
+#include <boost/throw_exception.hpp>
+
+#include <boost/task/exceptions.hpp>
+
+namespace boost {
+namespace tasks {
+namespace detail {
+
+inbox::inbox() :
+	mtx_(),
+	queue_(),
+	oldest_( -1),
+	active_( true)
+{}
+
+void
+inbox::take_( callable & ca)
+{
+	ca.swap( queue_.front().ca);
+	queue_.pop_front();
+	oldest_.store(
+		queue_.empty() ? -1 : queue_.front().stamp,
+		memory_order_relaxed);
+}
+
+bool
+inbox::empty() const
+{ return -1 == oldest_.load( memory_order_relaxed); }
+
+boost::int64_t
+inbox::oldest() const
+{ return oldest_.load( memory_order_relaxed); }
+
+bool
+inbox::put( callable const& ca, boost::int64_t stamp)
+{
+	mutex::scoped_lock lk( mtx_);
+	if ( ! active_)
+		BOOST_THROW_EXCEPTION( task_rejected("inbox is not active") );
+	bool first( queue_.empty() );
+	if ( first) oldest_.store( stamp, memory_order_relaxed);
+	queue_.push_back( entry( ca, stamp) );
+	return first;
+}
+
+bool
+inbox::try_take( callable & ca)
+{
+	if ( empty() ) return false;
+	mutex::scoped_lock lk( mtx_);
+	if ( queue_.empty() ) return false;
+	take_( ca);
+	return true;
+}
+
+bool
+inbox::try_steal( callable & ca, boost::int64_t posted_before)
+{
+	boost::int64_t oldest( oldest_.load( memory_order_relaxed) );
+	if ( -1 == oldest || oldest >= posted_before) return false;
+	mutex::scoped_lock lk( mtx_);
+	if ( queue_.empty() || queue_.front().stamp >= posted_before) return false;
+	take_( ca);
+	return true;
+}
+
+void
+inbox::deactivate()
+{
+	mutex::scoped_lock lk( mtx_);
+	active_ = false;
+}
+
+}}}
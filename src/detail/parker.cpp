@@ -0,0 +1,135 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include "boost/task/detail/parker.hpp"
+
+#if defined(__linux__)
+extern "C"
+{
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+}
+#endif
+
+#include <boost/cstdint.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/thread/locks.hpp>
+
+#include "boost/task/detail/clock.hpp"
+
+namespace {
+
+#if defined(__linux__)
+BOOST_STATIC_ASSERT( sizeof( boost::atomic< int >) == sizeof( int) );
+
+inline
+void futex_wait( boost::atomic< int > * addr, int value, timespec const* rel_time = 0)
+{
+	::syscall( SYS_futex, reinterpret_cast< int * >( addr),
+			   FUTEX_WAIT_PRIVATE, value, rel_time, 0, 0);
+}
+
+inline
+void futex_wake( boost::atomic< int > * addr)
+{
+	::syscall( SYS_futex, reinterpret_cast< int * >( addr),
+			   FUTEX_WAKE_PRIVATE, 1, 0, 0, 0);
+}
+#endif
+
+}
+
+namespace boost {
+namespace tasks {
+namespace detail {
+
+parker::parker() :
+	state_( EMPTY)
+#if ! defined(__linux__)
+	, mtx_(), cond_()
+#endif
+{}
+
+void
+parker::park()
+{
+	// NOTIFIED -> EMPTY: consume the token
+	// EMPTY -> PARKED: go to sleep
+	if ( NOTIFIED == state_.fetch_sub( 1, memory_order_acquire) ) return;
+
+#if defined(__linux__)
+	for (;;)
+	{
+		futex_wait( & state_, PARKED);
+		int expected = NOTIFIED;
+		if ( state_.compare_exchange_strong( expected, EMPTY, memory_order_acquire) )
+			return;
+		// spurious wake-up
+	}
+#else
+	unique_lock< mutex > lk( mtx_);
+	while ( NOTIFIED != state_.load( memory_order_acquire) )
+		cond_.wait( lk);
+	state_.store( EMPTY, memory_order_relaxed);
+#endif
+}
+
+bool
+parker::park_for( posix_time::time_duration const& timeout)
+{
+	if ( NOTIFIED == state_.fetch_sub( 1, memory_order_acquire) ) return true;
+
+	boost::int64_t deadline( monotonic_now() + timeout.total_microseconds() );
+#if defined(__linux__)
+	for (;;)
+	{
+		// the relative timeout of FUTEX_WAIT runs on CLOCK_MONOTONIC
+		boost::int64_t rel_time( deadline - monotonic_now() );
+		if ( 0 >= rel_time) break;
+		timespec ts;
+		ts.tv_sec = static_cast< time_t >( rel_time / 1000000);
+		ts.tv_nsec = static_cast< long >( rel_time % 1000000) * 1000;
+		futex_wait( & state_, PARKED, & ts);
+		int expected = NOTIFIED;
+		if ( state_.compare_exchange_strong( expected, EMPTY, memory_order_acquire) )
+			return true;
+	}
+#else
+	{
+		unique_lock< mutex > lk( mtx_);
+		while ( NOTIFIED != state_.load( memory_order_acquire) )
+		{
+			boost::int64_t rel_time( deadline - monotonic_now() );
+			if ( 0 >= rel_time) break;
+			cond_.timed_wait( lk, posix_time::microseconds( rel_time) );
+		}
+	}
+#endif
+
+	// timed out - withdraw from PARKED unless a token arrived meanwhile
+	int expected = PARKED;
+	if ( state_.compare_exchange_strong( expected, EMPTY, memory_order_acquire) )
+		return false;
+	state_.store( EMPTY, memory_order_relaxed);
+	return true;
+}
+
+void
+parker::unpark()
+{
+	if ( PARKED != state_.exchange( NOTIFIED, memory_order_release) ) return;
+
+#if defined(__linux__)
+	futex_wake( & state_);
+#else
+	lock_guard< mutex > lk( mtx_);
+	cond_.notify_one();
+#endif
+}
+
+}}}
@@ -0,0 +1,64 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include "boost/task/detail/stack_allocator.hpp"
+
+extern "C" {
+#include <sys/mman.h>
+#include <unistd.h>
+}
+
+#include <new>
+
+#include <boost/assert.hpp>
+
+#if ! defined(MAP_ANONYMOUS) && defined(MAP_ANON)
+# define MAP_ANONYMOUS MAP_ANON
+#endif
+
+namespace boost {
+namespace tasks {
+namespace detail {
+
+std::size_t
+stack_allocator::pagesize()
+{
+	static std::size_t size( ::sysconf( _SC_PAGESIZE) );
+	return size;
+}
+
+std::size_t
+stack_allocator::round( std::size_t size)
+{
+	std::size_t const page( pagesize() );
+	return ( ( size + page - 1) / page) * page;
+}
+
+stack
+stack_allocator::allocate( std::size_t size)
+{
+	std::size_t const usable( round( size) );
+	std::size_t const total( usable + pagesize() );
+	void * base( ::mmap( 0, total, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0) );
+	if ( MAP_FAILED == base) throw std::bad_alloc();
+	if ( 0 != ::mprotect( base, pagesize(), PROT_NONE) )
+	{
+		::munmap( base, total);
+		throw std::bad_alloc();
+	}
+	return stack( static_cast< char * >( base) + total, usable);
+}
+
+void
+stack_allocator::deallocate( stack const& stk)
+{
+	if ( ! stk.sp) return;
+	std::size_t const total( stk.size + pagesize() );
+	BOOST_ASSERT( 0 == ( total % pagesize() ) );
+	::munmap( static_cast< char * >( stk.sp) - total, total);
+}
+
+}}}
@@ -0,0 +1,58 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include "boost/task/detail/stack_allocator.hpp"
+
+extern "C" {
+#include <windows.h>
+}
+
+#include <new>
+
+namespace boost {
+namespace tasks {
+namespace detail {
+
+std::size_t
+stack_allocator::pagesize()
+{
+	SYSTEM_INFO si;
+	::GetSystemInfo( & si);
+	return static_cast< std::size_t >( si.dwPageSize);
+}
+
+std::size_t
+stack_allocator::round( std::size_t size)
+{
+	std::size_t const page( pagesize() );
+	return ( ( size + page - 1) / page) * page;
+}
+
+stack
+stack_allocator::allocate( std::size_t size)
+{
+	std::size_t const usable( round( size) );
+	std::size_t const total( usable + pagesize() );
+	void * base( ::VirtualAlloc( 0, total, MEM_COMMIT, PAGE_READWRITE) );
+	if ( ! base) throw std::bad_alloc();
+	DWORD old_options;
+	if ( ! ::VirtualProtect( base, pagesize(), PAGE_NOACCESS, & old_options) )
+	{
+		::VirtualFree( base, 0, MEM_RELEASE);
+		throw std::bad_alloc();
+	}
+	return stack( static_cast< char * >( base) + total, usable);
+}
+
+void
+stack_allocator::deallocate( stack const& stk)
+{
+	if ( ! stk.sp) return;
+	std::size_t const total( stk.size + pagesize() );
+	::VirtualFree( static_cast< char * >( stk.sp) - total, 0, MEM_RELEASE);
+}
+
+}}}
@@ -0,0 +1,117 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include "boost/task/detail/stack_cache.hpp"
+
+#include <boost/thread/locks.hpp>
+
+namespace boost {
+namespace tasks {
+namespace detail {
+
+stack_pool::stack_pool( std::size_t size, std::size_t workers) :
+	size_( stack_allocator::round( size) ),
+	workers_( workers),
+	cache_limit_( default_cache_limit),
+	mtx_(),
+	stacks_(),
+	mapped_( 0)
+{}
+
+stack_pool::~stack_pool()
+{
+	for ( std::vector< stack >::iterator i = stacks_.begin(); i != stacks_.end(); ++i)
+		stack_allocator::deallocate( * i);
+}
+
+std::size_t
+stack_pool::stacksize() const
+{ return size_; }
+
+std::size_t
+stack_pool::cache_limit() const
+{ return cache_limit_.load( memory_order_relaxed); }
+
+void
+stack_pool::cache_limit( std::size_t limit)
+{
+	cache_limit_.store( limit, memory_order_relaxed);
+	// drop the stacks above the new limit
+	lock_guard< mutex > lk( mtx_);
+	while ( stacks_.size() > limit * workers_)
+	{
+		stack_allocator::deallocate( stacks_.back() );
+		stacks_.pop_back();
+	}
+}
+
+std::size_t
+stack_pool::mapped() const
+{ return mapped_.load( memory_order_relaxed); }
+
+stack
+stack_pool::allocate()
+{
+	{
+		lock_guard< mutex > lk( mtx_);
+		if ( ! stacks_.empty() )
+		{
+			stack stk( stacks_.back() );
+			stacks_.pop_back();
+			return stk;
+		}
+	}
+	mapped_.fetch_add( 1, memory_order_relaxed);
+	return stack_allocator::allocate( size_);
+}
+
+void
+stack_pool::deallocate( stack const& stk)
+{
+	{
+		lock_guard< mutex > lk( mtx_);
+		if ( stacks_.size() < cache_limit() * workers_)
+		{
+			stacks_.push_back( stk);
+			return;
+		}
+	}
+	stack_allocator::deallocate( stk);
+}
+
+stack_cache::stack_cache( stack_pool & pool) :
+	pool_( pool),
+	stacks_()
+{ stacks_.reserve( pool_.cache_limit() ); }
+
+stack_cache::~stack_cache()
+{
+	while ( ! stacks_.empty() )
+	{
+		pool_.deallocate( stacks_.back() );
+		stacks_.pop_back();
+	}
+}
+
+stack
+stack_cache::allocate()
+{
+	if ( stacks_.empty() ) return pool_.allocate();
+	stack stk( stacks_.back() );
+	stacks_.pop_back();
+	return stk;
+}
+
+void
+stack_cache::deallocate( stack const& stk)
+{
+	if ( stacks_.size() < pool_.cache_limit() )
+		stacks_.push_back( stk);
+	else
+		pool_.deallocate( stk);
+}
+
+}}}
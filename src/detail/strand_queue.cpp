@@ -0,0 +1,129 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include "boost/task/detail/strand_queue.hpp"
+
+#include <boost/assert.hpp>
+#include <boost/thread/thread.hpp>
+
+namespace boost {
+namespace tasks {
+namespace detail {
+
+strand_queue::strand_queue() :
+	head_( & stub_),
+	tail_( & stub_),
+	stub_(),
+	pending_( 0)
+{}
+
+strand_queue::~strand_queue()
+{
+	node * n( pop_() );
+	while ( n)
+	{
+		delete n;
+		n = pop_();
+	}
+}
+
+void
+strand_queue::push_( node * n)
+{
+	n->next.store( 0, memory_order_relaxed);
+	node * prev( head_.exchange( n, memory_order_acq_rel) );
+	prev->next.store( n, memory_order_release);
+}
+
+// returns null if the queue is empty or a producer has not yet
+// linked its node - the caller does not wait for it
+strand_queue::node *
+strand_queue::pop_()
+{
+	node * tail( tail_);
+	node * next( tail->next.load( memory_order_acquire) );
+	if ( & stub_ == tail)
+	{
+		if ( ! next) return 0;
+		tail_ = next;
+		tail = next;
+		next = next->next.load( memory_order_acquire);
+	}
+	if ( next)
+	{
+		tail_ = next;
+		return tail;
+	}
+	if ( tail != head_.load( memory_order_acquire) ) return 0;
+	push_( & stub_);
+	next = tail->next.load( memory_order_acquire);
+	if ( ! next) return 0;
+	tail_ = next;
+	return tail;
+}
+
+bool
+strand_queue::push( callable const& ca)
+{
+	node * n( new node( ca) );
+	// counted before it is linked - run() never pops more tasks
+	// than pending_ accounts for
+	bool idle( 0 == pending_.fetch_add( 1, memory_order_acq_rel) );
+	push_( n);
+	return idle;
+}
+
+bool
+strand_queue::run( std::size_t max)
+{
+	std::size_t n( 0);
+	while ( n < max)
+	{
+		node * nd( pop_() );
+		// a producer is between its exchange and the link - the
+		// strand is rescheduled instead of spinning on it
+		if ( ! nd) break;
+		callable ca;
+		ca.swap( nd->ca);
+		delete nd;
+		++n;
+		// a throwing task must not wedge the strand - pending_ is
+		// decremented and the following tasks are executed
+		try
+		{ ca(); }
+		catch (...)
+		{}
+	}
+	BOOST_ASSERT( n <= pending_.load( memory_order_relaxed) );
+	return n != pending_.fetch_sub( n, memory_order_acq_rel);
+}
+
+void
+strand_queue::discard()
+{
+	for (;;)
+	{
+		std::size_t n( 0);
+		node * nd( pop_() );
+		while ( nd)
+		{
+			delete nd;
+			++n;
+			nd = pop_();
+		}
+		if ( n == pending_.fetch_sub( n, memory_order_acq_rel) ) return;
+		// a producer has counted its task but not yet linked it
+		this_thread::yield();
+	}
+}
+
+strand_array::strand_array( std::size_t size) :
+	use_count_( 0),
+	size_( size),
+	queues_( new strand_queue[size])
+{}
+
+}}}
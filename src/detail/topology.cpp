@@ -0,0 +1,168 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include "boost/task/detail/topology.hpp"
+
+#if defined(__linux__)
+extern "C"
+{
+#include <sched.h>
+}
+#endif
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+#include <boost/thread/once.hpp>
+
+namespace {
+
+boost::tasks::detail::topology const* instance_ = 0;
+boost::once_flag flag_ = BOOST_ONCE_INIT;
+
+bool read_line( std::string const& path, std::string & line)
+{
+	std::ifstream in( path.c_str() );
+	return in && std::getline( in, line);
+}
+
+std::string cpu_path( int cpu)
+{
+	std::ostringstream os;
+	os << "/sys/devices/system/cpu/cpu" << cpu;
+	return os.str();
+}
+
+// lowest CPU of the list - used as key of the group
+int group_of( std::string const& path, int cpu)
+{
+	std::string line;
+	if ( ! read_line( path, line) ) return cpu;
+	std::vector< int > cpus( boost::tasks::detail::topology::parse_cpu_list( line) );
+	return cpus.empty() ? cpu : * std::min_element( cpus.begin(), cpus.end() );
+}
+
+}
+
+namespace boost {
+namespace tasks {
+namespace detail {
+
+void
+topology::init_()
+{ instance_ = new topology(); }
+
+topology const&
+topology::instance()
+{
+	call_once( init_, flag_);
+	return * instance_;
+}
+
+int
+topology::current_cpu()
+{
+#if defined(__linux__)
+	return ::sched_getcpu();
+#else
+	return -1;
+#endif
+}
+
+std::vector< int >
+topology::parse_cpu_list( std::string const& str)
+{
+	// format: "0-3,8,10-11"
+	std::vector< int > cpus;
+	std::istringstream is( str);
+	std::string range;
+	while ( std::getline( is, range, ',') )
+	{
+		if ( range.empty() ) continue;
+		std::string::size_type pos = range.find( '-');
+		int first = std::atoi( range.substr( 0, pos).c_str() );
+		int last = std::string::npos == pos ? first : std::atoi( range.substr( pos + 1).c_str() );
+		for ( int cpu = first; cpu <= last; ++cpu)
+			cpus.push_back( cpu);
+	}
+	return cpus;
+}
+
+topology::topology() :
+	core_(), llc_(), node_()
+{
+#if defined(__linux__)
+	std::string line;
+	if ( ! read_line( "/sys/devices/system/cpu/possible", line) ) return;
+	std::vector< int > cpus( parse_cpu_list( line) );
+	if ( cpus.empty() ) return;
+	std::size_t n = * std::max_element( cpus.begin(), cpus.end() ) + 1;
+	core_.resize( n, 0);
+	llc_.resize( n, 0);
+	node_.resize( n, 0);
+
+	for ( std::vector< int >::iterator i = cpus.begin(); i != cpus.end(); ++i)
+	{
+		std::string path( cpu_path( * i) );
+		core_[* i] = group_of( path + "/topology/thread_siblings_list", * i);
+		// last-level cache is the cache with the highest level
+		llc_[* i] = core_[* i];
+		int max_level = 0;
+		for ( int idx = 0; ; ++idx)
+		{
+			std::ostringstream os;
+			os << path << "/cache/index" << idx;
+			if ( ! read_line( os.str() + "/level", line) ) break;
+			int level = std::atoi( line.c_str() );
+			if ( level < max_level) continue;
+			max_level = level;
+			llc_[* i] = group_of( os.str() + "/shared_cpu_list", * i);
+		}
+	}
+
+	if ( ! read_line( "/sys/devices/system/node/possible", line) ) return;
+	std::vector< int > nodes( parse_cpu_list( line) );
+	for ( std::vector< int >::iterator nd = nodes.begin(); nd != nodes.end(); ++nd)
+	{
+		std::ostringstream os;
+		os << "/sys/devices/system/node/node" << * nd << "/cpulist";
+		if ( ! read_line( os.str(), line) ) continue;
+		std::vector< int > members( parse_cpu_list( line) );
+		for ( std::vector< int >::iterator i = members.begin(); i != members.end(); ++i)
+			if ( static_cast< std::size_t >( * i) < n) node_[* i] = * nd;
+	}
+#endif
+}
+
+std::size_t
+topology::cpus() const
+{ return core_.size(); }
+
+int
+topology::core( int cpu) const
+{
+	if ( 0 > cpu || static_cast< std::size_t >( cpu) >= core_.size() )
+		return cpu;
+	return core_[cpu];
+}
+
+topology::level
+topology::distance( int a, int b) const
+{
+	if ( 0 > a || 0 > b ||
+		 static_cast< std::size_t >( a) >= core_.size() ||
+		 static_cast< std::size_t >( b) >= core_.size() )
+		// a worker-thread whose CPU is not known yet is probed last
+		return remote;
+	if ( core_[a] == core_[b]) return smt;
+	if ( llc_[a] == llc_[b]) return cache;
+	if ( node_[a] == node_[b]) return node;
+	return remote;
+}
+
+}}}
@@ -0,0 +1,165 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include "boost/task/detail/work.hpp"
+
+#include <new>
+
+#include <boost/assert.hpp>
+#include <boost/context/fcontext.hpp>
+#include <boost/exception_ptr.hpp>
+
+namespace boost {
+namespace tasks {
+namespace detail {
+
+struct work::fiber
+{
+	callable			ca;
+	stack				stk;
+	ctx::fcontext_t		caller;
+	ctx::fcontext_t	*	callee;
+	exception_ptr		except;
+	bool				complete;
+	// work-items run by run_inline() - callee points to own
+	promoter		*	prom;
+	ctx::fcontext_t		own;
+
+	fiber( callable const& ca_, stack const& stk_) :
+		ca( ca_), stk( stk_), caller(), callee( 0), except(), complete( false),
+		prom( 0), own()
+	{}
+};
+
+void
+work::entry_( intptr_t vp)
+{
+	fiber * fib( reinterpret_cast< fiber * >( vp) );
+	try
+	{ fib->ca(); }
+	catch ( ... )
+	{ fib->except = current_exception(); }
+	// release the callable while its stack is still alive
+	callable().swap( fib->ca);
+	fib->complete = true;
+	ctx::jump_fcontext( fib->callee, & fib->caller, 0);
+	BOOST_ASSERT( false && "completed work resumed");
+}
+
+void
+work::destroy_()
+{
+	// the control block lives on the stack of a former scheduler
+	if ( fib_->prom)
+	{
+		fib_ = 0;
+		return;
+	}
+	stack stk( fib_->stk);
+	fib_->~fiber();
+	fib_ = 0;
+	stack_allocator::deallocate( stk);
+}
+
+void
+work::run( stack_cache & stacks)
+{
+	if ( ! fib_)
+	{
+		BOOST_ASSERT( ! ca_.empty() );
+		stack stk( stacks.allocate() );
+		// the control block occupies the top of the stack, the
+		// fiber's frames start below it at a 16-byte boundary
+		uintptr_t top( reinterpret_cast< uintptr_t >( stk.sp) - sizeof( fiber) );
+		top &= ~static_cast< uintptr_t >( 15);
+		fib_ = new ( reinterpret_cast< void * >( top) ) fiber( ca_, stk);
+		callable().swap( ca_);
+		std::size_t size( stk.size - ( reinterpret_cast< uintptr_t >( stk.sp) - top) );
+		fib_->callee = ctx::make_fcontext( reinterpret_cast< void * >( top), size, & work::entry_);
+	}
+
+	intptr_t vp( ctx::jump_fcontext( & fib_->caller, fib_->callee, reinterpret_cast< intptr_t >( fib_) ) );
+
+	if ( 0 != vp)
+	{
+		// a promoted work-item completed, the scheduler on whose stack it
+		// ran has terminated and passes its stack
+		handoff * h( reinterpret_cast< handoff * >( vp) );
+		stack stk( h->stk);
+		exception_ptr except( h->except);
+		h->except = exception_ptr();
+		fib_ = 0;
+		if ( stk.sp) stacks.deallocate( stk);
+		if ( except) rethrow_exception( except);
+	}
+	else if ( fib_->complete)
+	{
+		stack stk( fib_->stk);
+		exception_ptr except( fib_->except);
+		fib_->~fiber();
+		fib_ = 0;
+		stacks.deallocate( stk);
+		if ( except) rethrow_exception( except);
+	}
+}
+
+bool
+work::run_inline( promoter & prom)
+{
+	BOOST_ASSERT( ! fib_);
+	BOOST_ASSERT( ! ca_.empty() );
+	fiber fib( ca_, stack() );
+	fib.prom = & prom;
+	callable().swap( ca_);
+	fib_ = & fib;
+	exception_ptr except;
+	try
+	{ fib.ca(); }
+	catch ( ... )
+	{
+		if ( ! fib.callee)
+		{
+			fib_ = 0;
+			throw;
+		}
+		except = current_exception();
+	}
+	if ( ! fib.callee)
+	{
+		fib_ = 0;
+		return true;
+	}
+	// promoted - this work-item was moved to the promoter, the scheduler
+	// which resumed it the last time continues
+	prom.handoff( fib.caller, except);
+	return false;
+}
+
+bool
+work::is_pinned() const
+{ return fib_ && fib_->prom; }
+
+void
+work::yield()
+{
+	BOOST_ASSERT( fib_);
+	// the work-item may be moved or resumed by another worker-thread,
+	// nothing but the control block is touched across the switch
+	fiber * fib( fib_);
+	if ( fib->prom && ! fib->callee)
+	{
+		// first suspension of a work-item running on the stack of the
+		// scheduler - the scheduler continues on another stack
+		fib->callee = & fib->own;
+		intptr_t vp( 0);
+		ctx::fcontext_t * next( fib->prom->promote( * this, vp) );
+		ctx::jump_fcontext( fib->callee, next, vp);
+		return;
+	}
+	ctx::jump_fcontext( fib->callee, & fib->caller, 0);
+}
+
+}}}
@@ -10,6 +10,29 @@ namespace boost {
 namespace tasks {
 namespace detail {
 
-thread_specific_ptr< worker > worker::tss_;
+#if defined(BOOST_TASK_TLS)
+BOOST_TASK_TLS worker_descriptor worker_tls = { 0, 0, 0 };
+#else
+namespace {
+
+void release_descriptor( worker_descriptor * desc)
+{ delete desc; }
+
+thread_specific_ptr< worker_descriptor > worker_tss( release_descriptor);
+
+}
+
+worker_descriptor & this_worker()
+{
+	worker_descriptor * desc( worker_tss.get() );
+	if ( ! desc)
+	{
+		worker_descriptor tmp = { 0, 0, 0 };
+		desc = new worker_descriptor( tmp);
+		worker_tss.reset( desc);
+	}
+	return * desc;
+}
+#endif
 
 }}}
@@ -0,0 +1,111 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include "boost/task/detail/worker_array.hpp"
+
+#include <boost/assert.hpp>
+#include <boost/integer_traits.hpp>
+
+namespace boost {
+namespace tasks {
+namespace detail {
+
+worker_array::worker_array( std::size_t size) :
+	slots_( size, static_cast< worker * >( 0) ),
+	replaced_( 0),
+	next_( 0)
+{}
+
+worker_array::worker_array( worker_array const& other, std::size_t idx, worker * w) :
+	slots_( other.slots_),
+	replaced_( 0),
+	next_( 0)
+{
+	BOOST_ASSERT( idx < slots_.size() );
+	slots_[idx] = w;
+}
+
+worker_registry::worker_registry( std::size_t size) :
+	current_( new worker_array( size) ),
+	epoch_( 1),
+	readers_( size),
+	slots_( new slot[size]),
+	limbo_( 0)
+{}
+
+worker_registry::~worker_registry()
+{
+	while ( limbo_)
+	{
+		worker_array * tmp( limbo_);
+		limbo_ = limbo_->next_;
+		delete tmp;
+	}
+	delete current_.load();
+}
+
+boost::uint64_t
+worker_registry::oldest_() const
+{
+	boost::uint64_t oldest( integer_traits< boost::uint64_t >::const_max);
+	for ( std::size_t i = 0; i < readers_; ++i)
+	{
+		boost::uint64_t epoch( slots_[i].epoch.load( memory_order_acquire) );
+		if ( 0 != epoch && epoch < oldest) oldest = epoch;
+	}
+	return oldest;
+}
+
+worker_array const&
+worker_registry::current() const
+{ return * current_.load( memory_order_relaxed); }
+
+void
+worker_registry::publish( worker_array * next)
+{
+	BOOST_ASSERT( next);
+	BOOST_ASSERT( next->size() == readers_);
+	worker_array * prev( current_.load( memory_order_relaxed) );
+	current_.store( next, memory_order_release);
+	// a reader which sees the new epoch sees the new array
+	prev->replaced_ = advance();
+	prev->next_ = limbo_;
+	limbo_ = prev;
+}
+
+bool
+worker_registry::reclaim()
+{
+	// a reader whose announcement is not seen here loads the array
+	// after it was replaced
+	atomic_thread_fence( memory_order_seq_cst);
+	boost::uint64_t oldest( oldest_() );
+	worker_array ** p( & limbo_);
+	while ( * p)
+	{
+		if ( ( * p)->replaced_ < oldest)
+		{
+			worker_array * tmp( * p);
+			* p = tmp->next_;
+			delete tmp;
+		}
+		else p = & ( * p)->next_;
+	}
+	return 0 == limbo_;
+}
+
+boost::uint64_t
+worker_registry::advance()
+{ return epoch_.fetch_add( 1, memory_order_acq_rel); }
+
+bool
+worker_registry::quiescent( boost::uint64_t epoch) const
+{
+	atomic_thread_fence( memory_order_seq_cst);
+	return epoch < oldest_();
+}
+
+}}}
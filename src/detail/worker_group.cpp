@@ -6,67 +6,114 @@
 
 #include "boost/task/detail/worker_group.hpp"
 
-#include <boost/foreach.hpp>
-#include <boost/utility.hpp>
+#include <boost/assert.hpp>
 
 namespace boost {
 namespace tasks {
 namespace detail {
 
 worker_group::~worker_group()
-{ if ( ! empty() ) join_all(); }
+{
+	if ( empty() ) return;
+	join_all();
+	clear();
+}
+
+void
+worker_group::publish_( std::size_t idx)
+{
+	registry_.publish(
+		new worker_array( registry_.current(), idx, worker_[idx].get() ) );
+	// a joined worker is released when no replaced array is left
+	if ( registry_.reclaim() ) joined_.clear();
+}
+
+void
+worker_group::retire( std::size_t idx)
+{
+	BOOST_ASSERT( idx < worker_.size() );
+	BOOST_ASSERT( worker_[idx]);
+	retired_.push_back( worker_[idx]);
+	worker_[idx].reset();
+	publish_( idx);
+	size_.fetch_sub( 1);
+}
+
+void
+worker_group::join_retired()
+{
+	for ( container_t::iterator i = retired_.begin(); i != retired_.end(); ++i)
+	{
+		( * i)->join();
+		joined_.push_back( * i);
+	}
+	retired_.clear();
+	if ( registry_.reclaim() ) joined_.clear();
+}
 
-const worker
+worker *
 worker_group::operator[]( std::size_t pos) const
-{ return worker_[pos]; }
+{ return worker_[pos].get(); }
+
+worker_registry const&
+worker_group::registry() const
+{ return registry_; }
+
+worker_registry &
+worker_group::registry()
+{ return registry_; }
 
 std::size_t
 worker_group::size() const
+{ return size_.load(); }
+
+std::size_t
+worker_group::capacity() const
 { return worker_.size(); }
 
 bool
 worker_group::empty() const
-{ return worker_.empty(); }
-
-const worker_group::iterator
-worker_group::begin()
-{ return worker_.begin(); }
-
-const worker_group::const_iterator
-worker_group::begin() const
-{ return worker_.begin(); }
-
-const worker_group::iterator
-worker_group::end()
-{ return worker_.end(); }
-
-const worker_group::const_iterator
-worker_group::end() const
-{ return worker_.end(); }
+{ return 0 == size(); }
 
 void
 worker_group::start_all()
 {
-	BOOST_FOREACH( worker & w, worker_)
-	{ w.start(); }
+	for ( container_t::iterator i = worker_.begin(); i != worker_.end(); ++i)
+		if ( * i) ( * i)->start();
 }
 
 void
 worker_group::join_all()
 {
-	BOOST_FOREACH( worker & w, worker_)
+	for ( container_t::iterator i = worker_.begin(); i != worker_.end(); ++i)
+		if ( * i) ( * i)->join();
+}
+
+void
+worker_group::discard_all()
+{
+	for ( container_t::iterator i = worker_.begin(); i != worker_.end(); ++i)
+		if ( * i) ( * i)->discard();
+}
+
+void
+worker_group::clear()
+{
+	for ( container_t::iterator i = worker_.begin(); i != worker_.end(); ++i)
 	{
-		if ( w.joinable() )
-		{ w.join(); }
+		if ( ! * i) continue;
+		i->reset();
+		publish_( i - worker_.begin() );
 	}
-	cont_.clear();
+	join_retired();
+	size_.store( 0);
 }
 
 void
 worker_group::interrupt_all()
 {
-	BOOST_FOREACH( worker & w, worker_)
-	{ w.interrupt(); }
+	for ( container_t::iterator i = worker_.begin(); i != worker_.end(); ++i)
+		if ( * i) ( * i)->interrupt();
 }
 
 }}}
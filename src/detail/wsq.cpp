@@ -6,115 +6,226 @@
 
 #include "boost/task/detail/wsq.hpp"
 
-#include <boost/thread/locks.hpp>
+#include <algorithm>
+
+#include <boost/assert.hpp>
 
 namespace boost {
 namespace tasks {
 namespace detail {
 
-wsq::wsq( fast_semaphore & fsem) :
-	initial_size_( 32),
-	array_( new callable[ initial_size_]),
-	capacity_( initial_size_),
-	mask_( initial_size_ - 1),
-	head_idx_( 0),
-	tail_idx_( 0),
-	mtx_(),
-	fsem_( fsem)
+wsq::array::array( std::size_t capacity_) :
+	capacity( capacity_),
+	mask( static_cast< index_t >( capacity_) - 1),
+	slots( new slot[capacity_]),
+	replaced( 0),
+	next( 0)
 {}
 
-bool
-wsq::empty() const
-{ return head_idx_.load() >= tail_idx_.load(); }
+wsq::array::~array()
+{ delete [] slots; }
 
-std::size_t
-wsq::size() const
-{ return tail_idx_.load() - head_idx_.load(); }
+wsq::array *
+wsq::array::resize( index_t top, index_t bottom, std::size_t capacity_) const
+{
+	array * a = new array( capacity_);
+	for ( index_t i = top; i != bottom; ++i)
+		a->put( i, get( i) );
+	return a;
+}
 
 void
-wsq::put( callable const& ca)
+wsq::retire_( array * a)
 {
-	unsigned int tail( tail_idx_.load() );
-	if ( tail <= head_idx_.load() + mask_)
-	{
-		array_[tail & mask_] = ca;
-		tail_idx_.fetch_add( 1);
-	}
-	else
-	{
-		lock_guard< recursive_mutex > lk( mtx_);
-		unsigned int head( head_idx_.load() );
-		int count( size() );
+	// thieves which entered the current epoch might still read
+	// from the old array
+	a->replaced = registry_.advance();
+	a->next = retired_;
+	retired_ = a;
+	reclaim_();
+}
 
-		if ( count >= mask_)
+void
+wsq::reclaim_()
+{
+	array ** p = & retired_;
+	while ( * p)
+	{
+		if ( registry_.quiescent( ( * p)->replaced) )
 		{
-			capacity_ <<= 1;
-			shared_array< callable > array( new callable[capacity_]);
-			for ( int i( 0); i != count; ++i)
-				array[i] = array_[(i + head) & mask_];
-			array_.swap( array);
-			head_idx_.store( 0);
-			tail = count;
-			tail_idx_.store( tail);
-			mask_ = (mask_ << 1) | 1;
+			array * a = * p;
+			* p = a->next;
+			delete a;
 		}
-		array_[tail & mask_] = ca;
-		tail_idx_.fetch_add( 1);
+		else p = & ( * p)->next;
+	}
+}
+
+void
+wsq::resize_( index_t top, index_t bottom, std::size_t capacity_)
+{
+	array * a = array_.load( memory_order_relaxed);
+	array * tmp = a->resize( top, bottom, capacity_);
+	array_.store( tmp, memory_order_seq_cst);
+	retire_( a);
+}
+
+void
+wsq::push_( work::raw const& r)
+{
+	index_t b = bottom_.load( memory_order_relaxed);
+	index_t t = top_.load( memory_order_acquire);
+	array * a = array_.load( memory_order_relaxed);
+	if ( b - t > a->mask)
+	{
+		// deque is full - grow without blocking the thieves
+		resize_( t, b, a->capacity << 1);
+		a = array_.load( memory_order_relaxed);
 	}
-	fsem_.post();
+	a->put( b, r);
+	bottom_.store( b + 1, memory_order_release);
 }
 
 bool
-wsq::try_take( callable & ca)
+wsq::take_( work::raw & r)
 {
-	unsigned int tail( tail_idx_.load() );
-	if ( tail == 0)
+	index_t b = bottom_.load( memory_order_relaxed) - 1;
+	array * a = array_.load( memory_order_relaxed);
+	bottom_.store( b, memory_order_relaxed);
+	atomic_thread_fence( memory_order_seq_cst);
+	index_t t = top_.load( memory_order_relaxed);
+
+	if ( t > b)
+	{
+		// deque was empty - return to the initial size
+		bottom_.store( b + 1, memory_order_relaxed);
+		if ( a->capacity > initial_capacity)
+			resize_( b + 1, b + 1, initial_capacity);
+		else if ( retired_)
+			reclaim_();
 		return false;
-	tail -= 1;
-	tail_idx_.exchange( tail);
-	//tail_idx_.store( tail);
-	if ( head_idx_.load() <= tail)
+	}
+
+	r = a->get( b);
+	if ( t == b)
 	{
-		ca.swap( array_[tail & mask_]);
-		return true;
+		// last item - race against thieves
+		bool taken = top_.compare_exchange_strong(
+				t, t + 1, memory_order_seq_cst, memory_order_relaxed);
+		bottom_.store( b + 1, memory_order_relaxed);
+		return taken;
 	}
-	else
+	if ( a->capacity > initial_capacity &&
+		 static_cast< std::size_t >( b - t) * shrink_factor < a->capacity)
+		// items [t,b) are still in the deque, thieves may take
+		// them from the old array while they are copied
+		resize_( t, b, a->capacity >> 1);
+	return true;
+}
+
+bool
+wsq::steal_( work::raw & r)
+{
+	index_t t = top_.load( memory_order_acquire);
+	atomic_thread_fence( memory_order_seq_cst);
+	index_t b = bottom_.load( memory_order_acquire);
+	if ( t >= b) return false;
+
+	array * a = array_.load( memory_order_seq_cst);
+	r = a->get( t);
+	return top_.compare_exchange_strong(
+			t, t + 1, memory_order_seq_cst, memory_order_relaxed);
+}
+
+wsq::wsq( worker_registry & registry) :
+	registry_( registry),
+	retired_( 0),
+	pad0_(),
+	top_( 0),
+	pad1_(),
+	bottom_( 0),
+	array_( new array( initial_capacity) ),
+	pad2_()
+{}
+
+wsq::~wsq()
+{
+	array * a = array_.load( memory_order_relaxed);
+	index_t b = bottom_.load( memory_order_relaxed);
+	for ( index_t i = top_.load( memory_order_relaxed); i < b; ++i)
+		work tmp( a->get( i) );
+	delete a;
+	// no thief is left
+	while ( retired_)
 	{
-		lock_guard< recursive_mutex > lk( mtx_);
-		if ( head_idx_.load() <= tail)
-		{
-			ca.swap( array_[tail & mask_]);
-			return true;
-		}
-		else
-		{
-			tail_idx_.fetch_add( 1);
-			return false;
-		}
+		a = retired_;
+		retired_ = a->next;
+		delete a;
 	}
 }
 
 bool
-wsq::try_steal( callable & ca)
+wsq::empty() const
+{ return bottom_.load( memory_order_relaxed) <= top_.load( memory_order_relaxed); }
+
+std::size_t
+wsq::size() const
 {
-	recursive_mutex::scoped_try_lock lk( mtx_);
-	if ( lk.owns_lock() )
+	index_t t = top_.load( memory_order_relaxed);
+	index_t b = bottom_.load( memory_order_relaxed);
+	return b > t ? static_cast< std::size_t >( b - t) : 0;
+}
+
+std::size_t
+wsq::capacity() const
+{ return array_.load( memory_order_relaxed)->capacity; }
+
+void
+wsq::put( BOOST_RV_REF( work) w)
+{ push_( w.release() ); }
+
+bool
+wsq::try_take( work & w)
+{
+	work::raw r;
+	if ( ! take_( r) ) return false;
+	work tmp( r);
+	w = boost::move( tmp);
+	return true;
+}
+
+bool
+wsq::try_steal( work & w)
+{
+	work::raw r;
+	if ( ! steal_( r) ) return false;
+	work tmp( r);
+	w = boost::move( tmp);
+	return true;
+}
+
+std::size_t
+wsq::try_steal( work & w, wsq & dst, std::size_t max)
+{
+	BOOST_ASSERT( this != & dst);
+
+	// steal up to half of the items found at the first probe, the first
+	// one is returned to the thief and the rest is moved into its own deque
+	// every item is claimed by its own CAS - a single CAS advancing top_
+	// by more than one would race with pops of the owner that skip the CAS
+	std::size_t n = ( std::min)( max, ( size() + 1) / 2);
+	if ( 0 == n) return 0;
+	work::raw r;
+	if ( ! steal_( r) ) return 0;
+	work tmp( r);
+	w = boost::move( tmp);
+	std::size_t stolen = 1;
+	for ( ; stolen < n; ++stolen)
 	{
-		unsigned int head( head_idx_.load() );
-		head_idx_.exchange( head + 1);
-		//head_idx_.store( head + 1);
-		if ( head < tail_idx_.load() )
-		{
-			ca.swap( array_[head & mask_]);
-			return true;
-		}
-		else
-		{
-			head_idx_.store( head);
-			return false;
-		}
+		if ( ! steal_( r) ) break;
+		dst.push_( r);
 	}
-	return false;
+	return stolen;
 }
 
 }}}
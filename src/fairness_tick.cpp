@@ -0,0 +1,32 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include "boost/task/fairness_tick.hpp"
+
+#include <boost/task/exceptions.hpp>
+
+namespace boost {
+namespace tasks {
+
+fairness_tick::fairness_tick(
+		std::size_t executions,
+		posix_time::time_duration const& interval) :
+	executions_( executions),
+	interval_( interval)
+{
+	if ( executions <= 0 || interval <= posix_time::time_duration() )
+		throw invalid_fairness_tick();
+}
+
+std::size_t
+fairness_tick::executions() const
+{ return executions_; }
+
+posix_time::time_duration
+fairness_tick::interval() const
+{ return interval_; }
+
+}}
@@ -0,0 +1,32 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include "boost/task/idle_strategy.hpp"
+
+#include <boost/task/exceptions.hpp>
+
+namespace boost {
+namespace tasks {
+
+idle_strategy::idle_strategy(
+		mode m,
+		posix_time::time_duration const& window) :
+	mode_( m),
+	window_( window)
+{
+	if ( m < spin || m > adaptive || window <= posix_time::time_duration() )
+		throw invalid_idle_strategy();
+}
+
+idle_strategy::mode
+idle_strategy::get_mode() const
+{ return mode_; }
+
+posix_time::time_duration
+idle_strategy::window() const
+{ return window_; }
+
+}}
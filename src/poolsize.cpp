@@ -6,15 +6,36 @@
 
 #include "boost/task/poolsize.hpp"
 
+#include <algorithm>
+#include <cmath>
+
+#include <boost/task/detail/cpu_quota.hpp>
 #include <boost/task/exceptions.hpp>
 
 namespace boost {
 namespace tasks {
 
 poolsize::poolsize( std::size_t value) :
-	value_( value)
+	value_( value), automatic_( false)
 { if ( value <= 0) throw invalid_poolsize(); }
 
+poolsize
+poolsize::automatic()
+{
+	std::size_t cpus( ( std::max)( detail::cpu_affinity(), std::size_t( 1) ) );
+	// a fraction of a CPU counts as a whole one
+	double quota( detail::cpu_quota() );
+	if ( 0 < quota && quota < cpus)
+		cpus = ( std::max)( static_cast< std::size_t >( std::ceil( quota) ), std::size_t( 1) );
+	poolsize psize( cpus);
+	psize.automatic_ = true;
+	return psize;
+}
+
+bool
+poolsize::is_automatic() const
+{ return automatic_; }
+
 poolsize::operator std::size_t () const
 { return value_; }
 
@@ -0,0 +1,67 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include "boost/task/processor_set.hpp"
+
+#if defined(BOOST_HAS_PROCESSOR_BINDINGS)
+
+#include <algorithm>
+
+#include <boost/assert.hpp>
+
+#include <boost/task/detail/topology.hpp>
+#include <boost/task/exceptions.hpp>
+
+namespace boost {
+namespace tasks {
+
+void
+processor_set::check_() const
+{
+	if ( cpus_.empty() ) throw invalid_processor_set();
+	std::vector< int > allowed( detail::allowed_processors() );
+	for ( std::vector< int >::const_iterator i = cpus_.begin(); i != cpus_.end(); ++i)
+		if ( ! std::binary_search( allowed.begin(), allowed.end(), * i) )
+			throw invalid_processor_set();
+}
+
+processor_set::processor_set() :
+	cpus_( detail::allowed_processors() )
+{ check_(); }
+
+processor_set::processor_set( std::string const& list) :
+	cpus_( detail::topology::parse_cpu_list( list) )
+{ check_(); }
+
+processor_set
+processor_set::without_smt_siblings() const
+{
+	detail::topology const& topo( detail::topology::instance() );
+	std::vector< int > cores, cpus;
+	for ( std::vector< int >::const_iterator i = cpus_.begin(); i != cpus_.end(); ++i)
+	{
+		int core( topo.core( * i) );
+		if ( cores.end() != std::find( cores.begin(), cores.end(), core) ) continue;
+		cores.push_back( core);
+		cpus.push_back( * i);
+	}
+	return processor_set( cpus.begin(), cpus.end() );
+}
+
+std::size_t
+processor_set::size() const
+{ return cpus_.size(); }
+
+int
+processor_set::operator[]( std::size_t i) const
+{
+	BOOST_ASSERT( i < cpus_.size() );
+	return cpus_[i];
+}
+
+}}
+
+#endif
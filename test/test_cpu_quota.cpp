@@ -0,0 +1,103 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include <sstream>
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+
+#include <boost/task/detail/cpu_quota.hpp>
+
+namespace tsk = boost::tasks;
+
+// check cgroup v2 cpu.max - unlimited, whole and fractional quotas
+void test_case_1()
+{
+	BOOST_CHECK_EQUAL( tsk::detail::cpu_max_quota("max 100000"), 0.);
+	BOOST_CHECK_EQUAL( tsk::detail::cpu_max_quota("200000 100000"), 2.);
+	BOOST_CHECK_EQUAL( tsk::detail::cpu_max_quota("150000 100000"), 1.5);
+	BOOST_CHECK_EQUAL( tsk::detail::cpu_max_quota("50000 100000"), .5);
+	BOOST_CHECK_EQUAL( tsk::detail::cpu_max_quota(""), 0.);
+	BOOST_CHECK_EQUAL( tsk::detail::cpu_max_quota("100000 0"), 0.);
+}
+
+// check cgroup v1 cpu.cfs_quota_us - -1 is unlimited
+void test_case_2()
+{
+	BOOST_CHECK_EQUAL( tsk::detail::cfs_quota( "-1", "100000"), 0.);
+	BOOST_CHECK_EQUAL( tsk::detail::cfs_quota( "400000", "100000"), 4.);
+	BOOST_CHECK_EQUAL( tsk::detail::cfs_quota( "25000", "100000"), .25);
+	BOOST_CHECK_EQUAL( tsk::detail::cfs_quota( "25000", "0"), 0.);
+}
+
+// check the cgroup directory - v2 and v1 hierarchies
+void test_case_3()
+{
+	std::string dir, mount_point;
+
+	std::istringstream mountinfo2(
+		"22 1 8:1 / / rw,relatime - ext4 /dev/sda1 rw\n"
+		"35 22 0:30 / /sys/fs/cgroup rw,nosuid - cgroup2 cgroup2 rw,nsdelegate\n");
+	std::istringstream cgroup2( "0::/user.slice/app.service\n");
+	BOOST_REQUIRE( tsk::detail::cgroup_dir( true, mountinfo2, cgroup2, dir, mount_point) );
+	BOOST_CHECK_EQUAL( mount_point, "/sys/fs/cgroup");
+	BOOST_CHECK_EQUAL( dir, "/sys/fs/cgroup/user.slice/app.service");
+
+	std::istringstream mountinfo1(
+		"30 25 0:26 / /sys/fs/cgroup/memory rw - cgroup cgroup rw,memory\n"
+		"31 25 0:27 / /sys/fs/cgroup/cpu,cpuacct rw - cgroup cgroup rw,cpu,cpuacct\n");
+	std::istringstream cgroup1(
+		"5:memory:/docker/abc\n"
+		"4:cpu,cpuacct:/docker/abc\n");
+	BOOST_REQUIRE( tsk::detail::cgroup_dir( false, mountinfo1, cgroup1, dir, mount_point) );
+	BOOST_CHECK_EQUAL( mount_point, "/sys/fs/cgroup/cpu,cpuacct");
+	BOOST_CHECK_EQUAL( dir, "/sys/fs/cgroup/cpu,cpuacct/docker/abc");
+
+	// no cgroup2 mount
+	std::istringstream mountinfo( "22 1 8:1 / / rw,relatime - ext4 /dev/sda1 rw\n");
+	std::istringstream cgroup( "0::/\n");
+	BOOST_CHECK( ! tsk::detail::cgroup_dir( true, mountinfo, cgroup, dir, mount_point) );
+}
+
+// check a nested cgroup root - the mount shows a sub-tree of the
+// hierarchy (cgroup namespace of a container)
+void test_case_4()
+{
+	std::string dir, mount_point;
+
+	std::istringstream mountinfo(
+		"35 22 0:30 /kubepods/pod1 /sys/fs/cgroup ro,nosuid - cgroup2 cgroup2 rw\n");
+	std::istringstream cgroup( "0::/kubepods/pod1/ctr\n");
+	BOOST_REQUIRE( tsk::detail::cgroup_dir( true, mountinfo, cgroup, dir, mount_point) );
+	BOOST_CHECK_EQUAL( dir, "/sys/fs/cgroup/ctr");
+
+	// the cgroup is the root of the mount
+	std::istringstream mountinfo_root(
+		"35 22 0:30 /kubepods/pod1 /sys/fs/cgroup ro,nosuid - cgroup2 cgroup2 rw\n");
+	std::istringstream cgroup_root( "0::/kubepods/pod1\n");
+	BOOST_REQUIRE( tsk::detail::cgroup_dir( true, mountinfo_root, cgroup_root, dir, mount_point) );
+	BOOST_CHECK_EQUAL( dir, "/sys/fs/cgroup");
+
+	// a sibling sharing the prefix of the root is not stripped
+	std::istringstream mountinfo_sibling(
+		"35 22 0:30 /kubepods/pod1 /sys/fs/cgroup ro,nosuid - cgroup2 cgroup2 rw\n");
+	std::istringstream cgroup_sibling( "0::/kubepods/pod10\n");
+	BOOST_REQUIRE( tsk::detail::cgroup_dir( true, mountinfo_sibling, cgroup_sibling, dir, mount_point) );
+	BOOST_CHECK_EQUAL( dir, "/sys/fs/cgroup/kubepods/pod10");
+}
+
+boost::unit_test::test_suite * init_unit_test_suite( int, char* [])
+{
+	boost::unit_test::test_suite * test =
+		BOOST_TEST_SUITE("Boost.Task: cpu-quota test suite");
+
+	test->add( BOOST_TEST_CASE( & test_case_1) );
+	test->add( BOOST_TEST_CASE( & test_case_2) );
+	test->add( BOOST_TEST_CASE( & test_case_3) );
+	test->add( BOOST_TEST_CASE( & test_case_4) );
+
+	return test;
+}
@@ -0,0 +1,133 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include <cstdlib>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/bind.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/ref.hpp>
+#include <boost/test/unit_test.hpp>
+#include <boost/thread.hpp>
+#include <boost/thread/barrier.hpp>
+#include <boost/utility.hpp>
+
+#include <boost/task/all.hpp>
+
+#include "test_functions.hpp"
+
+namespace pt = boost::posix_time;
+namespace tsk = boost::tasks;
+
+void double_barrier_fn( boost::barrier & b)
+{
+	b.wait();
+	b.wait();
+}
+
+// polls the size of the pool until it is n - the deadline only guards
+// against a hang, it is not part of the checked behaviour
+template< typename Pool >
+bool wait_for_size( Pool & pool, std::size_t n, pt::time_duration const& timeout)
+{
+	boost::system_time deadline( boost::get_system_time() + timeout);
+	while ( pool.size() != n)
+	{
+		if ( boost::get_system_time() >= deadline) return false;
+		boost::this_thread::sleep( pt::millisec( 10) );
+	}
+	return true;
+}
+
+// check bounds
+void test_case_1()
+{
+	BOOST_CHECK_THROW(
+		tsk::dynamic_pool< tsk::unbounded_fifo >(
+			tsk::poolsize( 4), tsk::poolsize( 2) ),
+		tsk::invalid_pool_bounds);
+
+	tsk::dynamic_pool<
+		tsk::unbounded_fifo
+	> pool( tsk::poolsize( 2), tsk::poolsize( 8) );
+	BOOST_CHECK( pool);
+	BOOST_CHECK_EQUAL( pool.size(), std::size_t( 2) );
+	BOOST_CHECK_EQUAL( pool.min_size(), std::size_t( 2) );
+	BOOST_CHECK_EQUAL( pool.max_size(), std::size_t( 8) );
+}
+
+// check submit
+void test_case_2()
+{
+	tsk::dynamic_pool<
+		tsk::unbounded_fifo
+	> pool( tsk::poolsize( 1), tsk::poolsize( 3) );
+	std::vector< int > buffer;
+	tsk::task< void > t(
+		pool.submit( boost::bind( buffer_fibonacci_fn, boost::ref( buffer), 10) ) );
+	t.wait();
+	BOOST_REQUIRE_EQUAL( buffer.size(), std::size_t( 1) );
+	BOOST_CHECK_EQUAL( buffer[0], 55);
+}
+
+// check that the pool grows to max_size if all worker-threads block
+void test_case_3()
+{
+	tsk::dynamic_pool<
+		tsk::unbounded_fifo
+	> pool( tsk::poolsize( 1), tsk::poolsize( 4) );
+	boost::barrier b( 5);
+	std::vector< tsk::task< void > > tasks;
+	for ( int i = 0; i < 4; ++i)
+		tasks.push_back( pool.submit( boost::bind( barrier_fn, boost::ref( b) ) ) );
+	b.wait();
+	BOOST_CHECK_EQUAL( pool.size(), std::size_t( 4) );
+	for ( std::size_t i = 0; i < tasks.size(); ++i)
+		tasks[i].wait();
+}
+
+// check that idle worker-threads retire after keep-alive
+void test_case_4()
+{
+	tsk::dynamic_pool<
+		tsk::unbounded_fifo
+	> pool(
+		tsk::poolsize( 1), tsk::poolsize( 4),
+		pt::millisec( 100), pt::millisec( 1) );
+	boost::barrier b( 5);
+	std::vector< tsk::task< void > > tasks;
+	for ( int i = 0; i < 4; ++i)
+		tasks.push_back( pool.submit( boost::bind( double_barrier_fn, boost::ref( b) ) ) );
+	// the worker-threads are blocked until the second wait, none
+	// of them can retire meanwhile
+	b.wait();
+	BOOST_CHECK_EQUAL( pool.size(), std::size_t( 4) );
+	b.wait();
+	for ( std::size_t i = 0; i < tasks.size(); ++i)
+		tasks[i].wait();
+	BOOST_CHECK( wait_for_size( pool, 1, pt::seconds( 30) ) );
+	BOOST_CHECK_EQUAL( pool.size(), std::size_t( 1) );
+	std::vector< int > buffer;
+	tsk::task< void > t(
+		pool.submit( boost::bind( buffer_fibonacci_fn, boost::ref( buffer), 10) ) );
+	t.wait();
+	BOOST_REQUIRE_EQUAL( buffer.size(), std::size_t( 1) );
+	BOOST_CHECK_EQUAL( buffer[0], 55);
+}
+
+boost::unit_test::test_suite * init_unit_test_suite( int, char* [])
+{
+	boost::unit_test::test_suite * test =
+		BOOST_TEST_SUITE("Boost.Task: dynamic-pool test suite");
+
+	test->add( BOOST_TEST_CASE( & test_case_1) );
+	test->add( BOOST_TEST_CASE( & test_case_2) );
+	test->add( BOOST_TEST_CASE( & test_case_3) );
+	test->add( BOOST_TEST_CASE( & test_case_4) );
+
+	return test;
+}
@@ -0,0 +1,238 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include <cstddef>
+#include <set>
+
+#include <boost/atomic.hpp>
+#include <boost/bind.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/ref.hpp>
+#include <boost/scoped_array.hpp>
+#include <boost/test/unit_test.hpp>
+#include <boost/thread.hpp>
+#include <boost/thread/barrier.hpp>
+
+#include <boost/task/detail/idle_set.hpp>
+#include <boost/task/detail/parker.hpp>
+
+namespace pt = boost::posix_time;
+namespace tsk = boost::tasks;
+
+// the parking protocol of the pool reduced to a counter of queued items
+struct scheduler
+{
+	std::size_t										size;
+	tsk::detail::idle_set							idle;
+	boost::scoped_array< tsk::detail::parker >		parkers;
+	boost::atomic< int >							queued;
+	boost::atomic< int >							executed;
+	boost::atomic< bool >							stop;
+
+	scheduler( std::size_t size_) :
+		size( size_), idle( size_), parkers( new tsk::detail::parker[size_]),
+		queued( 0), executed( 0), stop( false)
+	{}
+
+	bool try_take()
+	{
+		int n( queued.load() );
+		while ( 0 < n)
+			if ( queued.compare_exchange_weak( n, n - 1) ) return true;
+		return false;
+	}
+
+	// the work is visible before a parked worker-thread is claimed
+	void submit()
+	{
+		queued.fetch_add( 1);
+		std::size_t idx( 0);
+		if ( idle.claim( idx) ) parkers[idx].unpark();
+	}
+
+	void shutdown()
+	{
+		stop.store( true);
+		for ( std::size_t i = 0; i < size; ++i)
+			parkers[i].unpark();
+	}
+};
+
+void worker_fn( scheduler & s, std::size_t idx)
+{
+	while ( ! s.stop.load() )
+	{
+		if ( s.try_take() )
+		{
+			s.executed.fetch_add( 1);
+			continue;
+		}
+		// announce, re-check the queue a last time, park
+		s.idle.add( idx);
+		bool taken( s.try_take() );
+		if ( taken || s.stop.load() )
+		{
+			// a producer which claimed the worker meanwhile has
+			// posted a token - consume it
+			if ( ! s.idle.remove( idx) ) s.parkers[idx].park();
+			if ( taken) s.executed.fetch_add( 1);
+			continue;
+		}
+		s.parkers[idx].park();
+	}
+}
+
+void unpark_fn( tsk::detail::parker & p, boost::atomic< bool > & flag)
+{
+	boost::this_thread::sleep( pt::millisec( 10) );
+	flag.store( true);
+	p.unpark();
+}
+
+void search_fn(
+	tsk::detail::idle_set & s,
+	boost::atomic< int > & inside,
+	boost::atomic< int > & searches,
+	boost::atomic< int > & violations,
+	boost::barrier & b)
+{
+	b.wait();
+	for ( int i = 0; i < 10000; ++i)
+	{
+		if ( ! s.begin_search() ) continue;
+		if ( 0 != inside.fetch_add( 1) ) violations.fetch_add( 1);
+		searches.fetch_add( 1);
+		inside.fetch_sub( 1);
+		// the only searcher is always the last one
+		if ( ! s.end_search() ) violations.fetch_add( 1);
+	}
+}
+
+// check the token - an unpark() before park() lets park() return
+// at once, tokens do not accumulate
+void test_case_1()
+{
+	tsk::detail::parker p;
+	p.unpark();
+	p.unpark();
+	p.park();
+	BOOST_CHECK( ! p.park_for( pt::millisec( 10) ) );
+	p.unpark();
+	BOOST_CHECK( p.park_for( pt::millisec( 10) ) );
+}
+
+// check that park() sleeps until another thread unparks
+void test_case_2()
+{
+	tsk::detail::parker p;
+	boost::atomic< bool > flag( false);
+	boost::thread t(
+		boost::bind( unpark_fn, boost::ref( p), boost::ref( flag) ) );
+	p.park();
+	BOOST_CHECK( flag.load() );
+	t.join();
+}
+
+// check claim and remove - each parked worker is claimed once, a
+// claimed worker can not remove itself
+void test_case_3()
+{
+	tsk::detail::idle_set s( 130);
+	std::size_t idx( 0);
+	BOOST_CHECK( s.empty() );
+	BOOST_CHECK( ! s.claim( idx) );
+
+	s.add( 3);
+	s.add( 64);
+	s.add( 129);
+	BOOST_CHECK( ! s.empty() );
+
+	std::set< std::size_t > claimed;
+	for ( int i = 0; i < 3; ++i)
+	{
+		BOOST_REQUIRE( s.claim( idx) );
+		BOOST_CHECK( ! s.remove( idx) );
+		claimed.insert( idx);
+	}
+	BOOST_CHECK_EQUAL( claimed.size(), std::size_t( 3) );
+	BOOST_CHECK( claimed.count( 3) && claimed.count( 64) && claimed.count( 129) );
+	BOOST_CHECK( s.empty() );
+	BOOST_CHECK( ! s.claim( idx) );
+
+	s.add( 5);
+	BOOST_CHECK( s.remove( 5) );
+	BOOST_CHECK( ! s.claim( idx) );
+}
+
+// check the single searcher - begin_search() fails while another
+// worker-thread searches
+void test_case_4()
+{
+	tsk::detail::idle_set s( 4);
+	BOOST_CHECK_EQUAL( s.searching(), 0u);
+	BOOST_CHECK( s.begin_search() );
+	BOOST_CHECK( ! s.begin_search() );
+	BOOST_CHECK_EQUAL( s.searching(), 1u);
+	BOOST_CHECK( s.end_search() );
+	BOOST_CHECK_EQUAL( s.searching(), 0u);
+
+	std::size_t const threads( 4);
+	boost::atomic< int > inside( 0), searches( 0), violations( 0);
+	boost::barrier b( threads);
+	boost::thread_group tg;
+	for ( std::size_t i = 0; i < threads; ++i)
+		tg.create_thread(
+			boost::bind(
+				search_fn, boost::ref( s), boost::ref( inside),
+				boost::ref( searches), boost::ref( violations), boost::ref( b) ) );
+	tg.join_all();
+	BOOST_CHECK_EQUAL( violations.load(), 0);
+	BOOST_CHECK( 0 < searches.load() );
+	BOOST_CHECK_EQUAL( s.searching(), 0u);
+}
+
+// check that no wake-up gets lost - each item is submitted after the
+// previous one was executed, while the worker-threads park
+void test_case_5()
+{
+	std::size_t const workers( 4);
+	int const items( 2000);
+	scheduler s( workers);
+	boost::thread_group tg;
+	for ( std::size_t i = 0; i < workers; ++i)
+		tg.create_thread( boost::bind( worker_fn, boost::ref( s), i) );
+
+	int i( 0);
+	for ( ; i < items; ++i)
+	{
+		s.submit();
+		// the deadline only guards against a hang
+		boost::system_time deadline( boost::get_system_time() + pt::seconds( 10) );
+		while ( s.executed.load() != i + 1 && boost::get_system_time() < deadline)
+			boost::this_thread::yield();
+		if ( s.executed.load() != i + 1) break;
+	}
+	BOOST_CHECK_EQUAL( i, items);
+
+	s.shutdown();
+	tg.join_all();
+	BOOST_CHECK_EQUAL( s.executed.load(), i < items ? i + 1 : items);
+	BOOST_CHECK_EQUAL( s.queued.load(), 0);
+}
+
+boost::unit_test::test_suite * init_unit_test_suite( int, char* [])
+{
+	boost::unit_test::test_suite * test =
+		BOOST_TEST_SUITE("Boost.Task: idle-set test suite");
+
+	test->add( BOOST_TEST_CASE( & test_case_1) );
+	test->add( BOOST_TEST_CASE( & test_case_2) );
+	test->add( BOOST_TEST_CASE( & test_case_3) );
+	test->add( BOOST_TEST_CASE( & test_case_4) );
+	test->add( BOOST_TEST_CASE( & test_case_5) );
+
+	return test;
+}
@@ -0,0 +1,97 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include <cstddef>
+#include <vector>
+
+#include <boost/bind.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/test/unit_test.hpp>
+#include <boost/thread.hpp>
+
+#include <boost/task/all.hpp>
+
+#include "test_functions.hpp"
+
+namespace pt = boost::posix_time;
+namespace tsk = boost::tasks;
+
+typedef tsk::static_pool< tsk::unbounded_prio_queue< int > >	pool_type;
+
+int const low( 0);
+int const high( 10);
+
+// the general worker-threads are occupied by a long backfill of low
+// priority tasks - k tasks at the lane threshold submitted afterwards
+// are executed by the k lanes in parallel and do not wait behind it
+void check_lanes( std::size_t k)
+{
+	std::size_t const general( 2);
+	pt::time_duration const delay( pt::millisec( 50) );
+	pool_type pool( tsk::poolsize( k + general) );
+	pool.lanes( tsk::latency_lanes< int >( k, high) );
+	BOOST_REQUIRE_EQUAL( pool.lanes(), k);
+
+	// executed one after another by the general worker-threads
+	// the backfill lasts 40 * delay
+	for ( std::size_t i = 0; i < 40 * general; ++i)
+		pool.submit( boost::bind( delay_fn, delay), low);
+	boost::this_thread::sleep( pt::millisec( 20) );
+
+	pt::ptime start( pt::microsec_clock::universal_time() );
+	std::vector< tsk::task< void > * > tasks;
+	for ( std::size_t i = 0; i < k; ++i)
+		tasks.push_back(
+			new tsk::task< void >( pool.submit( boost::bind( delay_fn, delay), high) ) );
+	for ( std::size_t i = 0; i < k; ++i)
+	{
+		tasks[i]->get();
+		delete tasks[i];
+	}
+	pt::time_duration elapsed( pt::microsec_clock::universal_time() - start);
+
+	// one delay each, in parallel - generous slack for loaded machines,
+	// far below the backfill
+	BOOST_CHECK( elapsed < delay * 10);
+
+	pool.shutdown_now();
+}
+
+// check one lane
+void test_case_1()
+{ check_lanes( 1); }
+
+// check several lanes
+void test_case_2()
+{ check_lanes( 3); }
+
+// check release - without lanes every worker-thread runs all tasks
+void test_case_3()
+{
+	pool_type pool( tsk::poolsize( 3) );
+	pool.lanes( tsk::latency_lanes< int >( 2, high) );
+	BOOST_CHECK_EQUAL( pool.lanes(), std::size_t( 2) );
+	pool.lanes( tsk::latency_lanes< int >( 0, high) );
+	BOOST_CHECK_EQUAL( pool.lanes(), std::size_t( 0) );
+	BOOST_CHECK_THROW(
+		pool.lanes( tsk::latency_lanes< int >( 3, high) ),
+		tsk::invalid_latency_lanes);
+
+	tsk::task< int > t( pool.submit( boost::bind( fibonacci_fn, 10), low) );
+	BOOST_CHECK_EQUAL( t.get(), 55);
+}
+
+boost::unit_test::test_suite * init_unit_test_suite( int, char* [])
+{
+	boost::unit_test::test_suite * test =
+		BOOST_TEST_SUITE("Boost.Task: latency-lanes test suite");
+
+	test->add( BOOST_TEST_CASE( & test_case_1) );
+	test->add( BOOST_TEST_CASE( & test_case_2) );
+	test->add( BOOST_TEST_CASE( & test_case_3) );
+
+	return test;
+}
@@ -0,0 +1,130 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include <boost/bind.hpp>
+#include <boost/ref.hpp>
+#include <boost/test/unit_test.hpp>
+#include <boost/thread.hpp>
+
+#include <boost/task/detail/bind_processor.hpp>
+#include <boost/task/detail/topology.hpp>
+#include <boost/task/exceptions.hpp>
+#include <boost/task/processor_set.hpp>
+
+namespace tsk = boost::tasks;
+
+// check CPU lists - ranges and single CPUs, empty entries are skipped
+void test_case_1()
+{
+	std::vector< int > cpus( tsk::detail::topology::parse_cpu_list("0-3,8,10-11") );
+	int expected[] = { 0, 1, 2, 3, 8, 10, 11 };
+	BOOST_CHECK_EQUAL_COLLECTIONS(
+		cpus.begin(), cpus.end(), expected, expected + 7);
+
+	cpus = tsk::detail::topology::parse_cpu_list("5");
+	BOOST_REQUIRE_EQUAL( cpus.size(), std::size_t( 1) );
+	BOOST_CHECK_EQUAL( cpus[0], 5);
+
+	cpus = tsk::detail::topology::parse_cpu_list(",1,,2,");
+	BOOST_REQUIRE_EQUAL( cpus.size(), std::size_t( 2) );
+	BOOST_CHECK_EQUAL( cpus[0], 1);
+	BOOST_CHECK_EQUAL( cpus[1], 2);
+
+	BOOST_CHECK( tsk::detail::topology::parse_cpu_list("").empty() );
+}
+
+#if defined(BOOST_HAS_PROCESSOR_BINDINGS)
+void bind_fn( int cpu, bool & result)
+{ result = tsk::detail::bind_to_processor( cpu); }
+
+bool bind( int cpu)
+{
+	// the test thread keeps its affinity mask
+	bool result( false);
+	boost::thread t( boost::bind( bind_fn, cpu, boost::ref( result) ) );
+	t.join();
+	return result;
+}
+
+// check the default processor set - the CPUs of the affinity mask
+void test_case_2()
+{
+	std::vector< int > allowed( tsk::detail::allowed_processors() );
+	BOOST_REQUIRE( ! allowed.empty() );
+	tsk::processor_set ps;
+	BOOST_REQUIRE_EQUAL( ps.size(), allowed.size() );
+	for ( std::size_t i = 0; i < ps.size(); ++i)
+		BOOST_CHECK_EQUAL( ps[i], allowed[i]);
+}
+
+// check invalid processor sets - empty or with CPUs outside of the
+// affinity mask
+void test_case_3()
+{
+	std::vector< int > allowed( tsk::detail::allowed_processors() );
+	BOOST_REQUIRE( ! allowed.empty() );
+	std::vector< int > outside( 1, allowed.back() + 1);
+
+	BOOST_CHECK_THROW( tsk::processor_set(""), tsk::invalid_processor_set);
+	BOOST_CHECK_THROW(
+		tsk::processor_set( outside.begin(), outside.end() ),
+		tsk::invalid_processor_set);
+	tsk::processor_set ps( allowed.begin(), allowed.begin() + 1);
+	BOOST_CHECK_EQUAL( ps.size(), std::size_t( 1) );
+}
+
+// check SMT siblings - one CPU per core is kept, in the order of the set
+void test_case_4()
+{
+	tsk::processor_set ps;
+	tsk::processor_set cores( ps.without_smt_siblings() );
+	BOOST_CHECK( 0 < cores.size() );
+	BOOST_CHECK( cores.size() <= ps.size() );
+
+	tsk::detail::topology const& topo( tsk::detail::topology::instance() );
+	std::vector< int > seen;
+	std::size_t pos( 0);
+	for ( std::size_t i = 0; i < cores.size(); ++i)
+	{
+		int core( topo.core( cores[i]) );
+		BOOST_CHECK( seen.end() == std::find( seen.begin(), seen.end(), core) );
+		seen.push_back( core);
+		while ( pos < ps.size() && ps[pos] != cores[i]) ++pos;
+		BOOST_CHECK( pos < ps.size() );
+	}
+	for ( std::size_t i = 0; i < ps.size(); ++i)
+		BOOST_CHECK( seen.end() != std::find( seen.begin(), seen.end(), topo.core( ps[i]) ) );
+}
+
+// check binding - fails for a CPU outside of the affinity mask
+void test_case_5()
+{
+	std::vector< int > allowed( tsk::detail::allowed_processors() );
+	BOOST_REQUIRE( ! allowed.empty() );
+	BOOST_CHECK( bind( allowed.front() ) );
+	BOOST_CHECK( ! bind( allowed.back() + 1) );
+}
+#endif
+
+boost::unit_test::test_suite * init_unit_test_suite( int, char* [])
+{
+	boost::unit_test::test_suite * test =
+		BOOST_TEST_SUITE("Boost.Task: processor-set test suite");
+
+	test->add( BOOST_TEST_CASE( & test_case_1) );
+#if defined(BOOST_HAS_PROCESSOR_BINDINGS)
+	test->add( BOOST_TEST_CASE( & test_case_2) );
+	test->add( BOOST_TEST_CASE( & test_case_3) );
+	test->add( BOOST_TEST_CASE( & test_case_4) );
+	test->add( BOOST_TEST_CASE( & test_case_5) );
+#endif
+
+	return test;
+}
@@ -0,0 +1,160 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include <cstddef>
+
+#include <boost/atomic.hpp>
+#include <boost/bind.hpp>
+#include <boost/ref.hpp>
+#include <boost/test/unit_test.hpp>
+#include <boost/thread.hpp>
+#include <boost/thread/barrier.hpp>
+
+#include <boost/task/callable.hpp>
+#include <boost/task/context.hpp>
+#include <boost/task/sharded_fifo.hpp>
+
+namespace tsk = boost::tasks;
+
+typedef tsk::sharded_fifo< tsk::callable >	queue_type;
+
+// the callables of the test deliver no result
+struct null_promise
+{
+	void set() {}
+};
+
+struct count_fn
+{
+	boost::atomic< std::size_t >	*	executed;
+
+	count_fn( boost::atomic< std::size_t > & executed_) :
+		executed( & executed_)
+	{}
+
+	void operator()()
+	{ executed->fetch_add( 1); }
+};
+
+tsk::callable make_callable( boost::atomic< std::size_t > & executed)
+{
+	null_promise prom;
+	return tsk::callable( count_fn( executed), boost::move( prom), tsk::context() );
+}
+
+void produce_fn(
+	queue_type & q,
+	boost::atomic< std::size_t > & executed,
+	boost::atomic< std::size_t > & accepted,
+	boost::barrier & b)
+{
+	b.wait();
+	for ( std::size_t i = 0; i < 100000; ++i)
+	{
+		if ( ! q.try_put( make_callable( executed) ) ) return;
+		accepted.fetch_add( 1);
+	}
+}
+
+std::size_t drain( queue_type & q)
+{
+	std::size_t n( 0);
+	tsk::callable ca;
+	while ( q.try_take( ca) )
+	{
+		ca();
+		++n;
+	}
+	return n;
+}
+
+void consume_fn(
+	queue_type & q,
+	boost::atomic< std::size_t > & taken,
+	boost::atomic< bool > & done,
+	boost::barrier & b)
+{
+	b.wait();
+	while ( ! done.load() )
+		taken.fetch_add( drain( q) );
+}
+
+// check shards - the queue has the requested number of shards, at
+// least one
+void test_case_1()
+{
+	queue_type q1( 3);
+	BOOST_CHECK_EQUAL( q1.shards(), std::size_t( 3) );
+	queue_type q2( 0);
+	BOOST_CHECK_EQUAL( q2.shards(), std::size_t( 1) );
+}
+
+// check FIFO - the items of a single shard are taken in order
+void test_case_2()
+{
+	queue_type q( 1);
+	boost::atomic< std::size_t > executed( 0);
+	for ( std::size_t i = 0; i < 100; ++i)
+		q.put( make_callable( executed) );
+	BOOST_CHECK( ! q.empty() );
+	BOOST_CHECK_EQUAL( drain( q), std::size_t( 100) );
+	BOOST_CHECK_EQUAL( executed.load(), std::size_t( 100) );
+	BOOST_CHECK( q.empty() );
+}
+
+// check multiple producers and consumers - every accepted item is
+// taken exactly once, the queue is deactivated while producers push
+void test_case_3()
+{
+	std::size_t const producers( 4);
+	std::size_t const consumers( 2);
+	queue_type q( 4);
+	boost::atomic< std::size_t > executed( 0), accepted( 0), taken( 0);
+	boost::atomic< bool > done( false);
+	boost::barrier b( producers + consumers + 1);
+
+	boost::thread_group producer_group, consumer_group;
+	for ( std::size_t i = 0; i < producers; ++i)
+		producer_group.create_thread(
+			boost::bind(
+				produce_fn, boost::ref( q), boost::ref( executed),
+				boost::ref( accepted), boost::ref( b) ) );
+	for ( std::size_t i = 0; i < consumers; ++i)
+		consumer_group.create_thread(
+			boost::bind(
+				consume_fn, boost::ref( q), boost::ref( taken),
+				boost::ref( done), boost::ref( b) ) );
+	b.wait();
+
+	while ( accepted.load() < 1000)
+		boost::this_thread::yield();
+	// returns after the pushes in flight are linked
+	q.deactivate();
+	BOOST_CHECK( ! q.active() );
+	BOOST_CHECK( ! q.try_put( make_callable( executed) ) );
+	BOOST_CHECK_THROW( q.put( make_callable( executed) ), tsk::task_rejected);
+	producer_group.join_all();
+
+	done.store( true);
+	consumer_group.join_all();
+	taken.fetch_add( drain( q) );
+
+	BOOST_CHECK( q.empty() );
+	BOOST_CHECK_EQUAL( taken.load(), accepted.load() );
+	BOOST_CHECK_EQUAL( executed.load(), accepted.load() );
+}
+
+boost::unit_test::test_suite * init_unit_test_suite( int, char* [])
+{
+	boost::unit_test::test_suite * test =
+		BOOST_TEST_SUITE("Boost.Task: sharded-fifo test suite");
+
+	test->add( BOOST_TEST_CASE( & test_case_1) );
+	test->add( BOOST_TEST_CASE( & test_case_2) );
+	test->add( BOOST_TEST_CASE( & test_case_3) );
+
+	return test;
+}
@@ -0,0 +1,151 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include <cstddef>
+#include <cstring>
+#include <set>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <boost/task/detail/stack_allocator.hpp>
+#include <boost/task/detail/stack_cache.hpp>
+
+namespace tsk = boost::tasks;
+
+std::size_t const stack_size( 64 * 1024);
+
+// the usable part of a stack lies below sp
+void touch( tsk::detail::stack const& stk)
+{
+	char * base( static_cast< char * >( stk.sp) - stk.size);
+	std::memset( base, 0xab, stk.size);
+}
+
+// check that a released stack is handed out again without mapping
+// a new one
+void test_case_1()
+{
+	tsk::detail::stack_pool pool( stack_size, 1);
+	tsk::detail::stack_cache cache( pool);
+
+	tsk::detail::stack stk( cache.allocate() );
+	BOOST_REQUIRE( stk.sp);
+	BOOST_CHECK( stk.size >= stack_size);
+	BOOST_CHECK_EQUAL( pool.mapped(), std::size_t( 1) );
+	touch( stk);
+	void * sp( stk.sp);
+	cache.deallocate( stk);
+
+	for ( int i = 0; i < 100; ++i)
+	{
+		stk = cache.allocate();
+		BOOST_CHECK_EQUAL( stk.sp, sp);
+		cache.deallocate( stk);
+	}
+	BOOST_CHECK_EQUAL( pool.mapped(), std::size_t( 1) );
+}
+
+// check the limit - a worker-thread keeps cache_limit() stacks, the
+// pool cache_limit() stacks per worker-thread, further stacks are
+// unmapped
+void test_case_2()
+{
+	tsk::detail::stack_pool pool( stack_size, 1);
+	pool.cache_limit( 2);
+	BOOST_CHECK_EQUAL( pool.cache_limit(), std::size_t( 2) );
+	tsk::detail::stack_cache cache( pool);
+
+	std::vector< tsk::detail::stack > stacks;
+	std::set< void * > sps;
+	for ( int i = 0; i < 5; ++i)
+	{
+		stacks.push_back( cache.allocate() );
+		sps.insert( stacks.back().sp);
+	}
+	BOOST_CHECK_EQUAL( sps.size(), std::size_t( 5) );
+	BOOST_CHECK_EQUAL( pool.mapped(), std::size_t( 5) );
+	for ( std::size_t i = 0; i < stacks.size(); ++i)
+		cache.deallocate( stacks[i]);
+	stacks.clear();
+
+	// two stacks from the cache, two from the pool, one mapped anew -
+	// the address of the unmapped stack may be mapped again
+	for ( int i = 0; i < 5; ++i)
+	{
+		stacks.push_back( cache.allocate() );
+		touch( stacks.back() );
+	}
+	BOOST_CHECK_EQUAL( pool.mapped(), std::size_t( 6) );
+	for ( std::size_t i = 0; i < stacks.size(); ++i)
+		cache.deallocate( stacks[i]);
+}
+
+// check that lowering the limit drops the stacks of the pool above it
+void test_case_3()
+{
+	tsk::detail::stack_pool pool( stack_size, 2);
+	{
+		tsk::detail::stack_cache cache( pool);
+		std::vector< tsk::detail::stack > stacks;
+		for ( int i = 0; i < 4; ++i)
+			stacks.push_back( cache.allocate() );
+		for ( std::size_t i = 0; i < stacks.size(); ++i)
+			cache.deallocate( stacks[i]);
+	}
+	// the cache of the terminated worker-thread overflowed into the pool
+	BOOST_CHECK_EQUAL( pool.mapped(), std::size_t( 4) );
+	tsk::detail::stack stk( pool.allocate() );
+	BOOST_CHECK_EQUAL( pool.mapped(), std::size_t( 4) );
+	pool.deallocate( stk);
+
+	pool.cache_limit( 0);
+	stk = pool.allocate();
+	BOOST_CHECK_EQUAL( pool.mapped(), std::size_t( 5) );
+	pool.deallocate( stk);
+
+	// nothing is cached any more
+	tsk::detail::stack_cache cache( pool);
+	stk = cache.allocate();
+	cache.deallocate( stk);
+	stk = cache.allocate();
+	BOOST_CHECK_EQUAL( pool.mapped(), std::size_t( 7) );
+	cache.deallocate( stk);
+}
+
+// check that the stacks of one worker-thread are reused by another one
+// through the pool
+void test_case_4()
+{
+	tsk::detail::stack_pool pool( stack_size, 2);
+	pool.cache_limit( 1);
+	tsk::detail::stack_cache c1( pool);
+	tsk::detail::stack_cache c2( pool);
+
+	tsk::detail::stack s1( c1.allocate() );
+	tsk::detail::stack s2( c1.allocate() );
+	// s1 stays in the cache of c1, s2 overflows into the pool
+	c1.deallocate( s1);
+	c1.deallocate( s2);
+
+	tsk::detail::stack stk( c2.allocate() );
+	BOOST_CHECK_EQUAL( stk.sp, s2.sp);
+	BOOST_CHECK_EQUAL( pool.mapped(), std::size_t( 2) );
+	c2.deallocate( stk);
+}
+
+boost::unit_test::test_suite * init_unit_test_suite( int, char* [])
+{
+	boost::unit_test::test_suite * test =
+		BOOST_TEST_SUITE("Boost.Task: stack-cache test suite");
+
+	test->add( BOOST_TEST_CASE( & test_case_1) );
+	test->add( BOOST_TEST_CASE( & test_case_2) );
+	test->add( BOOST_TEST_CASE( & test_case_3) );
+	test->add( BOOST_TEST_CASE( & test_case_4) );
+
+	return test;
+}
@@ -0,0 +1,116 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/atomic.hpp>
+#include <boost/bind.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/ref.hpp>
+#include <boost/test/unit_test.hpp>
+#include <boost/thread.hpp>
+
+#include <boost/task/all.hpp>
+
+#include "test_functions.hpp"
+
+namespace pt = boost::posix_time;
+namespace tsk = boost::tasks;
+
+typedef tsk::static_pool< tsk::unbounded_fifo >	pool_type;
+
+void append_fn( std::vector< int > & v, int i)
+{ v.push_back( i); }
+
+// returns true if the other task of the pair entered while this one
+// was running
+bool rendezvous_fn( boost::atomic< int > & entered)
+{
+	entered.fetch_add( 1);
+	boost::system_time abs_time( boost::get_system_time() + pt::seconds( 5) );
+	while ( 2 > entered.load() )
+	{
+		if ( boost::get_system_time() >= abs_time) return false;
+		boost::this_thread::yield();
+	}
+	return true;
+}
+
+// check FIFO order - the tasks of a strand are executed one at a time
+// in the order of submission
+void test_case_1()
+{
+	pool_type pool( tsk::poolsize( 4) );
+	tsk::strand< pool_type > s( pool);
+	std::vector< int > v;
+
+	for ( int i = 0; i < 999; ++i)
+		s.submit( boost::bind( append_fn, boost::ref( v), i) );
+	tsk::task< void > t(
+		s.submit( boost::bind( append_fn, boost::ref( v), 999) ) );
+	t.wait();
+
+	BOOST_REQUIRE_EQUAL( v.size(), std::size_t( 1000) );
+	for ( int i = 0; i < 1000; ++i)
+		BOOST_CHECK_EQUAL( v[i], i);
+}
+
+// check parallel execution - the tasks of different strands run on
+// different worker-threads at the same time
+void test_case_2()
+{
+	pool_type pool( tsk::poolsize( 2) );
+	tsk::keyed_strand< pool_type > s( pool, 2);
+	boost::atomic< int > entered( 0);
+
+	tsk::task< bool > t1(
+		s.submit( 0, boost::bind( rendezvous_fn, boost::ref( entered) ) ) );
+	tsk::task< bool > t2(
+		s.submit( 1, boost::bind( rendezvous_fn, boost::ref( entered) ) ) );
+	BOOST_CHECK( t1.get() );
+	BOOST_CHECK( t2.get() );
+}
+
+// check recovery - a throwing task does not stop the strand, the
+// following tasks are executed
+void test_case_3()
+{
+	pool_type pool( tsk::poolsize( 2) );
+	tsk::strand< pool_type > s( pool);
+
+	tsk::task< void > t1( s.submit( throwing_fn) );
+	tsk::task< int > t2( s.submit( boost::bind( fibonacci_fn, 10) ) );
+	BOOST_CHECK_THROW( t1.get(), std::exception);
+	BOOST_CHECK_EQUAL( t2.get(), 55);
+
+	// the strand is idle again and is scheduled by the next submission
+	tsk::task< int > t3( s.submit( boost::bind( fibonacci_fn, 5) ) );
+	BOOST_CHECK_EQUAL( t3.get(), 5);
+}
+
+// check rejection - a closed pool does not accept strand tasks
+void test_case_4()
+{
+	pool_type pool( tsk::poolsize( 1) );
+	tsk::strand< pool_type > s( pool);
+	pool.shutdown();
+	BOOST_CHECK_THROW( s.submit( boost::bind( fibonacci_fn, 10) ), tsk::task_rejected);
+}
+
+boost::unit_test::test_suite * init_unit_test_suite( int, char* [])
+{
+	boost::unit_test::test_suite * test =
+		BOOST_TEST_SUITE("Boost.Task: strand test suite");
+
+	test->add( BOOST_TEST_CASE( & test_case_1) );
+	test->add( BOOST_TEST_CASE( & test_case_2) );
+	test->add( BOOST_TEST_CASE( & test_case_3) );
+	test->add( BOOST_TEST_CASE( & test_case_4) );
+
+	return test;
+}
@@ -0,0 +1,160 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include <cstddef>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <boost/task/bounded_fifo.hpp>
+#include <boost/task/bounded_prio_queue.hpp>
+#include <boost/task/callable.hpp>
+#include <boost/task/context.hpp>
+#include <boost/task/unbounded_fifo.hpp>
+#include <boost/task/unbounded_prio_queue.hpp>
+#include <boost/task/watermark.hpp>
+
+namespace tsk = boost::tasks;
+
+std::size_t const items( 10);
+
+// the callables of the test deliver no result
+struct null_promise
+{
+	void set() {}
+};
+
+// records its value when executed
+struct record_fn
+{
+	std::vector< int >	*	order;
+	int						value;
+
+	record_fn( std::vector< int > & order_, int value_) :
+		order( & order_), value( value_)
+	{}
+
+	void operator()()
+	{ order->push_back( value); }
+};
+
+tsk::callable make_callable( std::vector< int > & order, int value)
+{
+	null_promise prom;
+	return tsk::callable( record_fn( order, value), boost::move( prom), tsk::context() );
+}
+
+// takes up to n items and executes them, returns the number taken
+template< typename Queue >
+std::size_t take_n( Queue & q, std::size_t n, std::size_t parts)
+{
+	tsk::callable buffer[items];
+	std::size_t taken( q.try_take_n( buffer, n, parts) );
+	BOOST_CHECK( taken <= n);
+	for ( std::size_t i = 0; i < taken; ++i)
+		buffer[i]();
+	return taken;
+}
+
+// items 0..9 are taken in submission order - first at most n, then
+// the share of one of two consumers, then the rest
+template< typename Queue >
+void check_fifo( Queue & q)
+{
+	std::vector< int > order;
+	for ( std::size_t i = 0; i < items; ++i)
+		q.put( make_callable( order, static_cast< int >( i) ) );
+
+	BOOST_CHECK_EQUAL( take_n( q, 4, 1), std::size_t( 4) );
+	// 6 items left, one of two consumers gets 3
+	BOOST_CHECK_EQUAL( take_n( q, items, 2), std::size_t( 3) );
+	BOOST_CHECK_EQUAL( take_n( q, items, 1), std::size_t( 3) );
+	BOOST_CHECK_EQUAL( take_n( q, items, 1), std::size_t( 0) );
+	BOOST_CHECK( q.empty() );
+
+	BOOST_REQUIRE_EQUAL( order.size(), items);
+	for ( std::size_t i = 0; i < items; ++i)
+		BOOST_CHECK_EQUAL( order[i], static_cast< int >( i) );
+}
+
+// items are put in mixed priority order and taken highest first,
+// also across several calls
+template< typename Queue >
+void check_prio( Queue & q)
+{
+	int const prios[items] = { 3, 7, 1, 9, 5, 0, 8, 2, 6, 4 };
+	std::vector< int > order;
+	for ( std::size_t i = 0; i < items; ++i)
+		q.put( typename Queue::value_type( make_callable( order, prios[i]), prios[i]) );
+
+	BOOST_CHECK_EQUAL( take_n( q, 4, 1), std::size_t( 4) );
+	BOOST_CHECK_EQUAL( take_n( q, items, 2), std::size_t( 3) );
+	BOOST_CHECK_EQUAL( take_n( q, items, 1), std::size_t( 3) );
+	BOOST_CHECK_EQUAL( take_n( q, items, 1), std::size_t( 0) );
+	BOOST_CHECK( q.empty() );
+
+	BOOST_REQUIRE_EQUAL( order.size(), items);
+	for ( std::size_t i = 0; i < items; ++i)
+		BOOST_CHECK_EQUAL( order[i], static_cast< int >( items - 1 - i) );
+}
+
+// check try_take_n on unbounded_fifo
+void test_case_1()
+{
+	tsk::unbounded_fifo< tsk::callable > q;
+	check_fifo( q);
+}
+
+// check try_take_n on bounded_fifo
+void test_case_2()
+{
+	tsk::bounded_fifo< tsk::callable > q(
+		tsk::high_watermark( 20),
+		tsk::low_watermark( 10) );
+	check_fifo( q);
+}
+
+// check try_take_n on unbounded_prio_queue
+void test_case_3()
+{
+	tsk::unbounded_prio_queue< tsk::callable, int > q;
+	check_prio( q);
+}
+
+// check try_take_n on bounded_prio_queue
+void test_case_4()
+{
+	tsk::bounded_prio_queue< tsk::callable, int > q(
+		tsk::high_watermark( 20),
+		tsk::low_watermark( 10) );
+	check_prio( q);
+}
+
+// check that a single item is handed out even if the share of one
+// consumer rounds down to zero
+void test_case_5()
+{
+	std::vector< int > order;
+	tsk::unbounded_fifo< tsk::callable > q;
+	q.put( make_callable( order, 0) );
+	BOOST_CHECK_EQUAL( take_n( q, items, 4), std::size_t( 1) );
+	BOOST_CHECK_EQUAL( take_n( q, items, 4), std::size_t( 0) );
+	BOOST_CHECK_EQUAL( order.size(), std::size_t( 1) );
+}
+
+boost::unit_test::test_suite * init_unit_test_suite( int, char* [])
+{
+	boost::unit_test::test_suite * test =
+		BOOST_TEST_SUITE("Boost.Task: try_take_n test suite");
+
+	test->add( BOOST_TEST_CASE( & test_case_1) );
+	test->add( BOOST_TEST_CASE( & test_case_2) );
+	test->add( BOOST_TEST_CASE( & test_case_3) );
+	test->add( BOOST_TEST_CASE( & test_case_4) );
+	test->add( BOOST_TEST_CASE( & test_case_5) );
+
+	return test;
+}
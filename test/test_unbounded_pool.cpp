@@ -7,13 +7,16 @@
 #include <cstdlib>
 #include <iostream>
 #include <map>
+#include <set>
 #include <stdexcept>
 #include <vector>
 
+#include <boost/atomic.hpp>
 #include <boost/bind.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
 #include <boost/function.hpp>
 #include <boost/ref.hpp>
+#include <boost/scoped_array.hpp>
 #include <boost/test/unit_test.hpp>
 #include <boost/thread.hpp>
 #include <boost/thread/barrier.hpp>
@@ -27,6 +30,232 @@
 namespace pt = boost::posix_time;
 namespace tsk = boost::tasks;
 
+// suspends once - with lazy fibers the task is promoted to a fiber
+int yield_fibonacci_fn( int n)
+{
+	boost::this_task::yield();
+	return fibonacci_fn( n);
+}
+
+void yield_throwing_fn()
+{
+	boost::this_task::yield();
+	throwing_fn();
+}
+
+// records the worker-threads executing the task before and after
+// the suspension
+void yield_worker_fn(
+	boost::thread::id & before,
+	boost::thread::id & after,
+	boost::barrier & b)
+{
+	before = boost::this_task::worker_id();
+	boost::this_task::yield();
+	after = boost::this_task::worker_id();
+	b.wait();
+}
+
+void worker_id_fn( boost::thread::id & id)
+{ id = boost::this_task::worker_id(); }
+
+// true if the awaited task was executed by the waiting worker-thread
+template< typename Pool >
+bool get_inline_fn( Pool & pool, bool wait)
+{
+	boost::thread::id id;
+	tsk::task< void > t(
+		pool.submit( boost::bind( worker_id_fn, boost::ref( id) ) ) );
+	if ( wait) t.wait();
+	else t.get();
+	return id == boost::this_task::worker_id();
+}
+
+int started_fibonacci_fn(
+	boost::atomic< bool > & started,
+	boost::atomic< int > & runs,
+	int n)
+{
+	started.store( true);
+	runs.fetch_add( 1);
+	boost::this_thread::sleep( pt::millisec( 100) );
+	return fibonacci_fn( n);
+}
+
+// awaits a task which another worker-thread has already started
+template< typename Pool >
+int get_started_fn( Pool & pool, boost::atomic< int > & runs)
+{
+	boost::atomic< bool > started( false);
+	tsk::task< int > t(
+		pool.submit(
+			boost::bind(
+				started_fibonacci_fn, boost::ref( started),
+				boost::ref( runs), 10) ) );
+	while ( ! started.load() )
+		boost::this_thread::sleep( pt::millisec( 1) );
+	return t.get();
+}
+
+void count_fn( boost::atomic< int > & runs)
+{ runs.fetch_add( 1); }
+
+// spawns n tasks to the worker-queue of its worker-thread and blocks
+// the worker-thread until it is interrupted
+template< typename Pool >
+void spawn_block_fn(
+	Pool & pool,
+	std::vector< tsk::task< void > > & tasks,
+	int n,
+	boost::barrier & b)
+{
+	for ( int i = 0; i < n; ++i)
+		tasks.push_back(
+			pool.submit( boost::bind( delay_fn, pt::millisec( 1) ) ) );
+	b.wait();
+	boost::this_thread::sleep( pt::seconds( 5) );
+}
+
+void push_fn( std::vector< int > & buffer, int i)
+{ buffer.push_back( i); }
+
+// the task spawned last takes the run-next slot, the one spawned
+// before is moved to the worker-queue
+template< typename Pool >
+void spawn_push_fn( Pool & pool, std::vector< int > & buffer)
+{
+	for ( int i = 0; i < 3; ++i)
+		pool.submit( boost::bind( push_fn, boost::ref( buffer), i) );
+}
+
+void count_id_fn( boost::atomic< int > & runs, boost::thread::id & id)
+{
+	id = boost::this_task::worker_id();
+	runs.fetch_add( 1);
+}
+
+// blocks its worker-thread without helping - the task in the run-next
+// slot and the one displaced into the worker-queue are stolen
+template< typename Pool >
+bool spawn_stolen_fn( Pool & pool)
+{
+	boost::atomic< int > runs( 0);
+	boost::thread::id first, second;
+	tsk::task< void > t1(
+		pool.submit( boost::bind( count_id_fn, boost::ref( runs), boost::ref( first) ) ) );
+	tsk::task< void > t2(
+		pool.submit( boost::bind( count_id_fn, boost::ref( runs), boost::ref( second) ) ) );
+	// the deadline only guards against a hang
+	boost::system_time deadline( boost::get_system_time() + pt::seconds( 10) );
+	while ( 2 != runs.load() && boost::get_system_time() < deadline)
+		boost::this_thread::sleep( pt::millisec( 1) );
+	bool stolen( 2 == runs.load() );
+	t1.wait();
+	t2.wait();
+	boost::thread::id self( boost::this_task::worker_id() );
+	return stolen && first != self && second != self;
+}
+
+// spawns n tasks and awaits them at once - idle worker-threads steal
+// them while they are awaited
+template< typename Pool >
+void get_spawned_fn( Pool & pool, boost::atomic< int > * runs, int n)
+{
+	std::vector< tsk::task< void > > tasks;
+	for ( int i = 0; i < n; ++i)
+		tasks.push_back(
+			pool.submit( boost::bind( count_fn, boost::ref( runs[i]) ) ) );
+	for ( std::size_t i = 0; i < tasks.size(); ++i)
+		tasks[i].get();
+}
+
+// blocks its worker-thread until the spawned task was resumed - the
+// spawned task has to be stolen by another worker-thread
+template< typename Pool >
+void spawn_yield_fn(
+	Pool & pool,
+	boost::thread::id & spawner,
+	boost::thread::id & before,
+	boost::thread::id & after)
+{
+	spawner = boost::this_task::worker_id();
+	boost::barrier b( 2);
+	pool.submit(
+		boost::bind(
+			yield_worker_fn, boost::ref( before),
+			boost::ref( after), boost::ref( b) ) );
+	b.wait();
+}
+
+void yield_push_fn( std::vector< int > & buffer, int i)
+{
+	buffer.push_back( i);
+	boost::this_task::yield();
+	buffer.push_back( i + 10);
+}
+
+// both tasks are suspended before the first one is resumed
+template< typename Pool >
+void spawn_yield_push_fn( Pool & pool, std::vector< int > & buffer)
+{
+	for ( int i = 0; i < 2; ++i)
+		pool.submit( boost::bind( yield_push_fn, boost::ref( buffer), i) );
+}
+
+// blocks its worker-thread until released
+void gate_fn( boost::atomic< bool > & started, boost::atomic< bool > & release)
+{
+	started.store( true);
+	// the deadline only guards against a hang
+	boost::system_time deadline( boost::get_system_time() + pt::seconds( 10) );
+	while ( ! release.load() && boost::get_system_time() < deadline)
+		boost::this_thread::sleep( pt::millisec( 1) );
+}
+
+void resume_worker_fn(
+	boost::thread::id & before,
+	boost::thread::id & after,
+	boost::atomic< bool > & done)
+{
+	before = boost::this_task::worker_id();
+	boost::this_task::yield();
+	after = boost::this_task::worker_id();
+	done.store( true);
+}
+
+// the spawned task suspends on this worker-thread, which then blocks -
+// the other worker-thread is released from the gate and has to resume
+// the task from the ready-queue of this one
+template< typename Pool >
+void spawn_resume_fn(
+	Pool & pool,
+	boost::atomic< bool > & started,
+	boost::atomic< bool > & release,
+	boost::thread::id & before,
+	boost::thread::id & after,
+	boost::atomic< bool > & done)
+{
+	// the other worker-thread must not steal the spawned task
+	while ( ! started.load() )
+		boost::this_thread::sleep( pt::millisec( 1) );
+	pool.submit(
+		boost::bind(
+			resume_worker_fn, boost::ref( before),
+			boost::ref( after), boost::ref( done) ) );
+	// the spawned task runs and suspends behind this one
+	boost::this_task::yield();
+	release.store( true);
+	boost::system_time deadline( boost::get_system_time() + pt::seconds( 10) );
+	while ( ! done.load() && boost::get_system_time() < deadline)
+		boost::this_thread::sleep( pt::millisec( 1) );
+}
+
+void timed_worker_id_fn( boost::thread::id & id, pt::ptime & started)
+{
+	started = pt::microsec_clock::universal_time();
+	id = boost::this_task::worker_id();
+}
+
 // check size and move op
 void test_case_1()
 {
@@ -408,6 +637,398 @@ void test_case_22()
 	BOOST_CHECK_EQUAL( buffer.size(), std::size_t( 2) );
 }
 
+// check shutdown_now breaks the promises of queued tasks
+void test_case_23()
+{
+	tsk::static_pool<
+		tsk::unbounded_fifo
+	> pool( tsk::poolsize( 1) );
+	tsk::task< void > t1( delay_fn, pt::millisec( 500) );
+	tsk::task< void > t2( delay_fn, pt::millisec( 500) );
+	tsk::handle< void > h1(
+		tsk::async( boost::move( t1), pool) );
+	boost::this_thread::sleep( pt::millisec( 250) );
+	tsk::handle< void > h2(
+		tsk::async( boost::move( t2), pool) );
+	pool.shutdown_now();
+	BOOST_CHECK_THROW( h1.get(), tsk::task_interrupted);
+	BOOST_CHECK_THROW( h2.get(), boost::broken_promise);
+}
+
+// check that a task which does not suspend never gets a fiber if
+// fibers are created lazily
+void test_case_24()
+{
+	typedef tsk::static_pool<
+		tsk::unbounded_fifo
+	> pool_type;
+	pool_type pool( tsk::poolsize( 2) );
+	pool.lazy_fibers( true);
+	BOOST_CHECK( pool.lazy_fibers() );
+	std::vector< tsk::task< int > > tasks;
+	for ( int i = 0; i < 100; ++i)
+		tasks.push_back( pool.submit( boost::bind( fibonacci_fn, 10) ) );
+	for ( std::size_t i = 0; i < tasks.size(); ++i)
+		BOOST_CHECK_EQUAL( tasks[i].get(), 55);
+	tsk::statistics st( pool.statistics() );
+	BOOST_CHECK_EQUAL( st.stacks_mapped, std::size_t( 0) );
+	BOOST_CHECK_EQUAL( st.promotions, std::size_t( 0) );
+}
+
+// check that a lazy task which suspends is promoted to a fiber,
+// resumed and completed
+void test_case_25()
+{
+	typedef tsk::static_pool<
+		tsk::unbounded_fifo
+	> pool_type;
+	pool_type pool( tsk::poolsize( 1) );
+	pool.lazy_fibers( true);
+	tsk::task< int > t( pool.submit( boost::bind( yield_fibonacci_fn, 10) ) );
+	BOOST_CHECK_EQUAL( t.get(), 55);
+	tsk::statistics st( pool.statistics() );
+	BOOST_CHECK_EQUAL( st.promotions, std::size_t( 1) );
+	BOOST_CHECK( 0 < st.stacks_mapped);
+	// the worker-thread goes on with the next task
+	tsk::task< int > t2( pool.submit( boost::bind( fibonacci_fn, 10) ) );
+	BOOST_CHECK_EQUAL( t2.get(), 55);
+}
+
+// check that a lazy task stolen from the worker-queue of its spawner
+// is promoted and resumed by the worker-thread which stole it - a
+// promoted task is pinned to that worker-thread
+void test_case_26()
+{
+	typedef tsk::static_pool<
+		tsk::unbounded_fifo
+	> pool_type;
+	pool_type pool( tsk::poolsize( 2) );
+	pool.lazy_fibers( true);
+	boost::thread::id spawner, before, after;
+	tsk::task< void > t(
+		pool.submit(
+			boost::bind(
+				spawn_yield_fn< pool_type >, boost::ref( pool),
+				boost::ref( spawner), boost::ref( before), boost::ref( after) ) ) );
+	t.wait();
+	pool.shutdown();
+	BOOST_CHECK( spawner != boost::thread::id() );
+	BOOST_CHECK( before != spawner);
+	BOOST_CHECK( before == after);
+	tsk::statistics st( pool.statistics() );
+	BOOST_CHECK_EQUAL( st.promotions, std::size_t( 1) );
+}
+
+// check interrupt of a lazy task which was not started yet
+void test_case_27()
+{
+	typedef tsk::static_pool<
+		tsk::unbounded_fifo
+	> pool_type;
+	pool_type pool( tsk::poolsize( 1) );
+	pool.lazy_fibers( true);
+	boost::barrier b( 2);
+	tsk::task< void > t1( pool.submit( boost::bind( barrier_fn, boost::ref( b) ) ) );
+	tsk::task< void > t2( pool.submit( boost::bind( delay_fn, pt::seconds( 3) ) ) );
+	t2.interrupt();
+	BOOST_CHECK( t2.interruption_requested() );
+	b.wait();
+	BOOST_CHECK_THROW( t2.get(), tsk::task_interrupted);
+	BOOST_CHECK_EQUAL( pool.statistics().promotions, std::size_t( 0) );
+	// the worker-thread is not interrupted by a later task
+	tsk::task< int > t3( pool.submit( boost::bind( fibonacci_fn, 10) ) );
+	BOOST_CHECK_EQUAL( t3.get(), 55);
+}
+
+// check an exception thrown by a promoted task
+void test_case_28()
+{
+	typedef tsk::static_pool<
+		tsk::unbounded_fifo
+	> pool_type;
+	pool_type pool( tsk::poolsize( 1) );
+	pool.lazy_fibers( true);
+	tsk::task< void > t1( pool.submit( boost::bind( yield_throwing_fn) ) );
+	BOOST_CHECK_THROW( t1.get(), std::runtime_error);
+	BOOST_CHECK_EQUAL( pool.statistics().promotions, std::size_t( 1) );
+	tsk::task< int > t2( pool.submit( boost::bind( yield_fibonacci_fn, 10) ) );
+	BOOST_CHECK_EQUAL( t2.get(), 55);
+	BOOST_CHECK_EQUAL( pool.statistics().promotions, std::size_t( 2) );
+}
+
+// check that a worker-thread waiting for a task which was not started
+// executes it - with a single worker-thread it would block otherwise
+void test_case_29()
+{
+	typedef tsk::static_pool<
+		tsk::unbounded_fifo
+	> pool_type;
+	pool_type pool( tsk::poolsize( 1) );
+	tsk::task< bool > t1(
+		pool.submit( boost::bind( get_inline_fn< pool_type >, boost::ref( pool), false) ) );
+	BOOST_CHECK( t1.get() );
+	tsk::task< bool > t2(
+		pool.submit( boost::bind( get_inline_fn< pool_type >, boost::ref( pool), true) ) );
+	BOOST_CHECK( t2.get() );
+}
+
+// check that a task started by another worker-thread is not executed
+// again by the worker-thread waiting for it
+void test_case_30()
+{
+	typedef tsk::static_pool<
+		tsk::unbounded_fifo
+	> pool_type;
+	pool_type pool( tsk::poolsize( 2) );
+	boost::atomic< int > runs( 0);
+	tsk::task< int > t(
+		pool.submit(
+			boost::bind(
+				get_started_fn< pool_type >, boost::ref( pool), boost::ref( runs) ) ) );
+	BOOST_CHECK_EQUAL( t.get(), 55);
+	BOOST_CHECK_EQUAL( runs.load(), 1);
+}
+
+// check that each awaited task runs once while waiters and thieves
+// race for it
+void test_case_31()
+{
+	typedef tsk::static_pool<
+		tsk::unbounded_fifo
+	> pool_type;
+	pool_type pool( tsk::poolsize( 4) );
+	int const waiters( 8), spawned( 100);
+	boost::scoped_array< boost::atomic< int > > runs(
+		new boost::atomic< int >[waiters * spawned]);
+	for ( int i = 0; i < waiters * spawned; ++i)
+		runs[i].store( 0);
+	std::vector< tsk::task< void > > tasks;
+	for ( int i = 0; i < waiters; ++i)
+		tasks.push_back(
+			pool.submit(
+				boost::bind(
+					get_spawned_fn< pool_type >, boost::ref( pool),
+					runs.get() + i * spawned, spawned) ) );
+	for ( std::size_t i = 0; i < tasks.size(); ++i)
+		tasks[i].get();
+	int once( 0);
+	for ( int i = 0; i < waiters * spawned; ++i)
+		if ( 1 == runs[i].load() ) ++once;
+	BOOST_CHECK_EQUAL( once, waiters * spawned);
+}
+
+// check shutdown_now breaks the promises of the tasks left in the
+// worker-queue
+void test_case_32()
+{
+	typedef tsk::static_pool<
+		tsk::unbounded_fifo
+	> pool_type;
+	pool_type pool( tsk::poolsize( 1) );
+	std::vector< tsk::task< void > > tasks;
+	boost::barrier b( 2);
+	tsk::task< void > t(
+		pool.submit(
+			boost::bind(
+				spawn_block_fn< pool_type >, boost::ref( pool),
+				boost::ref( tasks), 10, boost::ref( b) ) ) );
+	b.wait();
+	pool.shutdown_now();
+	BOOST_CHECK_THROW( t.get(), tsk::task_interrupted);
+	BOOST_REQUIRE_EQUAL( tasks.size(), std::size_t( 10) );
+	for ( std::size_t i = 0; i < tasks.size(); ++i)
+		BOOST_CHECK_THROW( tasks[i].get(), boost::broken_promise);
+}
+
+// check that the task spawned last runs first - it is swapped into the
+// run-next slot
+void test_case_33()
+{
+	typedef tsk::static_pool<
+		tsk::unbounded_fifo
+	> pool_type;
+	pool_type pool( tsk::poolsize( 1) );
+	std::vector< int > buffer;
+	tsk::task< void > t(
+		pool.submit(
+			boost::bind(
+				spawn_push_fn< pool_type >, boost::ref( pool), boost::ref( buffer) ) ) );
+	t.wait();
+	pool.shutdown();
+	BOOST_REQUIRE_EQUAL( buffer.size(), std::size_t( 3) );
+	BOOST_CHECK_EQUAL( buffer[0], 2);
+	BOOST_CHECK_EQUAL( buffer[1], 1);
+	BOOST_CHECK_EQUAL( buffer[2], 0);
+}
+
+// check that the task displaced from the run-next slot and the one in
+// the slot are stolen while their spawner blocks
+void test_case_34()
+{
+	typedef tsk::static_pool<
+		tsk::unbounded_fifo
+	> pool_type;
+	pool_type pool( tsk::poolsize( 2) );
+	tsk::task< bool > t(
+		pool.submit( boost::bind( spawn_stolen_fn< pool_type >, boost::ref( pool) ) ) );
+	BOOST_CHECK( t.get() );
+	BOOST_CHECK( 2 <= pool.statistics().steals);
+}
+
+// check that suspended tasks are resumed from the ready-queue in the
+// order they were suspended
+void test_case_35()
+{
+	typedef tsk::static_pool<
+		tsk::unbounded_fifo
+	> pool_type;
+	pool_type pool( tsk::poolsize( 1) );
+	std::vector< int > buffer;
+	tsk::task< void > t(
+		pool.submit(
+			boost::bind(
+				spawn_yield_push_fn< pool_type >, boost::ref( pool), boost::ref( buffer) ) ) );
+	t.wait();
+	pool.shutdown();
+	// the task spawned last runs first from the run-next slot
+	BOOST_REQUIRE_EQUAL( buffer.size(), std::size_t( 4) );
+	BOOST_CHECK_EQUAL( buffer[0], 1);
+	BOOST_CHECK_EQUAL( buffer[1], 0);
+	BOOST_CHECK_EQUAL( buffer[2], 11);
+	BOOST_CHECK_EQUAL( buffer[3], 10);
+}
+
+// check that a suspended task is resumed by another worker-thread
+// while its own worker-thread is blocked
+void test_case_36()
+{
+	typedef tsk::static_pool<
+		tsk::unbounded_fifo
+	> pool_type;
+	pool_type pool( tsk::poolsize( 2) );
+	boost::atomic< bool > started( false), release( false), done( false);
+	boost::thread::id before, after;
+	tsk::task< void > t1(
+		pool.submit( boost::bind( gate_fn, boost::ref( started), boost::ref( release) ) ) );
+	tsk::task< void > t2(
+		pool.submit(
+			boost::bind(
+				spawn_resume_fn< pool_type >, boost::ref( pool),
+				boost::ref( started), boost::ref( release),
+				boost::ref( before), boost::ref( after), boost::ref( done) ) ) );
+	t1.wait();
+	t2.wait();
+	pool.shutdown();
+	BOOST_CHECK( done.load() );
+	BOOST_CHECK( before != boost::thread::id() );
+	BOOST_CHECK( after != boost::thread::id() );
+	BOOST_CHECK( before != after);
+	BOOST_CHECK( 1 <= pool.statistics().steals);
+}
+
+// check that a task with an affinity hint runs on the worker-thread
+// selected by the hint - modulo the number of worker-threads
+void test_case_37()
+{
+	typedef tsk::static_pool<
+		tsk::unbounded_fifo
+	> pool_type;
+	std::size_t const size( 4);
+	pool_type pool( tsk::poolsize( size) );
+	std::set< boost::thread::id > workers;
+	for ( std::size_t k = 0; k < size; ++k)
+	{
+		std::set< boost::thread::id > ids;
+		for ( int i = 0; i < 10; ++i)
+		{
+			boost::thread::id id;
+			tsk::task< void > t(
+				pool.submit(
+					boost::bind( worker_id_fn, boost::ref( id) ),
+					tsk::affinity( k + ( i % 2) * size) ) );
+			t.wait();
+			ids.insert( id);
+		}
+		BOOST_CHECK_EQUAL( ids.size(), std::size_t( 1) );
+		workers.insert( * ids.begin() );
+	}
+	BOOST_CHECK_EQUAL( workers.size(), size);
+	tsk::statistics st( pool.statistics() );
+	BOOST_CHECK_EQUAL( st.posted, 10 * size);
+	BOOST_CHECK_EQUAL( st.posted_stolen, std::size_t( 0) );
+}
+
+// check that a task whose hinted worker-thread is blocked is taken
+// over by another worker-thread, but not before affinity_delay
+void test_case_38()
+{
+	typedef tsk::static_pool<
+		tsk::unbounded_fifo
+	> pool_type;
+	pool_type pool( tsk::poolsize( 2) );
+	boost::thread::id hinted;
+	tsk::task< void > t1(
+		pool.submit( boost::bind( worker_id_fn, boost::ref( hinted) ), tsk::affinity( 0) ) );
+	t1.wait();
+
+	boost::atomic< bool > started( false), release( false);
+	tsk::task< void > t2(
+		pool.submit(
+			boost::bind( gate_fn, boost::ref( started), boost::ref( release) ),
+			tsk::affinity( 0) ) );
+	while ( ! started.load() )
+		boost::this_thread::sleep( pt::millisec( 1) );
+
+	boost::thread::id id;
+	pt::ptime started_at;
+	pt::ptime submitted( pt::microsec_clock::universal_time() );
+	tsk::task< void > t3(
+		pool.submit(
+			boost::bind( timed_worker_id_fn, boost::ref( id), boost::ref( started_at) ),
+			tsk::affinity( 0) ) );
+	t3.wait();
+	release.store( true);
+	t2.wait();
+
+	BOOST_CHECK( id != boost::thread::id() );
+	BOOST_CHECK( id != hinted);
+	BOOST_CHECK( started_at - submitted >= pt::millisec( 1) );
+	BOOST_CHECK_EQUAL( pool.statistics().posted_stolen, std::size_t( 1) );
+}
+
+// check that each idle strategy picks up tasks submitted to idle
+// worker-threads and lets the pool shut down
+void test_case_39()
+{
+	typedef tsk::static_pool<
+		tsk::unbounded_fifo
+	> pool_type;
+	tsk::idle_strategy::mode const modes[] = {
+		tsk::idle_strategy::spin,
+		tsk::idle_strategy::yield,
+		tsk::idle_strategy::park,
+		tsk::idle_strategy::adaptive };
+	for ( std::size_t m = 0; m < sizeof( modes) / sizeof( modes[0]); ++m)
+	{
+		pool_type pool( tsk::poolsize( 2) );
+		pool.idle( tsk::idle_strategy( modes[m]) );
+		for ( int i = 0; i < 50; ++i)
+		{
+			// the worker-threads go idle between two tasks
+			tsk::task< int > t( pool.submit( boost::bind( fibonacci_fn, 10) ) );
+			BOOST_CHECK_EQUAL( t.get(), 55);
+			if ( 0 == i % 10)
+				boost::this_thread::sleep( pt::millisec( 1) );
+		}
+		tsk::statistics st( pool.statistics() );
+		if ( tsk::idle_strategy::park == modes[m])
+			BOOST_CHECK_EQUAL( st.spin_time, std::size_t( 0) );
+		pool.shutdown();
+		BOOST_CHECK( pool.closed() );
+		BOOST_CHECK_EQUAL( pool.size(), std::size_t( 0) );
+	}
+}
+
 boost::unit_test::test_suite * init_unit_test_suite( int, char* [])
 {
 	boost::unit_test::test_suite * test =
@@ -435,6 +1056,23 @@ boost::unit_test::test_suite * init_unit_test_suite( int, char* [])
 	test->add( BOOST_TEST_CASE( & test_case_20) );
 	test->add( BOOST_TEST_CASE( & test_case_21) );
 	test->add( BOOST_TEST_CASE( & test_case_22) );
+	test->add( BOOST_TEST_CASE( & test_case_23) );
+	test->add( BOOST_TEST_CASE( & test_case_24) );
+	test->add( BOOST_TEST_CASE( & test_case_25) );
+	test->add( BOOST_TEST_CASE( & test_case_26) );
+	test->add( BOOST_TEST_CASE( & test_case_27) );
+	test->add( BOOST_TEST_CASE( & test_case_28) );
+	test->add( BOOST_TEST_CASE( & test_case_29) );
+	test->add( BOOST_TEST_CASE( & test_case_30) );
+	test->add( BOOST_TEST_CASE( & test_case_31) );
+	test->add( BOOST_TEST_CASE( & test_case_32) );
+	test->add( BOOST_TEST_CASE( & test_case_33) );
+	test->add( BOOST_TEST_CASE( & test_case_34) );
+	test->add( BOOST_TEST_CASE( & test_case_35) );
+	test->add( BOOST_TEST_CASE( & test_case_36) );
+	test->add( BOOST_TEST_CASE( & test_case_37) );
+	test->add( BOOST_TEST_CASE( & test_case_38) );
+	test->add( BOOST_TEST_CASE( & test_case_39) );
 
 	return test;
 }
@@ -0,0 +1,118 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include <cstddef>
+
+#include <boost/atomic.hpp>
+#include <boost/bind.hpp>
+#include <boost/ref.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <boost/task/all.hpp>
+
+namespace tsk = boost::tasks;
+
+void increment_fn( boost::atomic< int > & count)
+{ count.fetch_add( 1); }
+
+// spawns n tasks from inside the pool without waiting for them
+template< typename Pool >
+void spawn_fn( Pool & pool, boost::atomic< int > & count, int n)
+{
+	for ( int i = 0; i < n; ++i)
+		pool.submit( boost::bind( increment_fn, boost::ref( count) ) );
+}
+
+// each task spawns its successor, n tasks deep
+template< typename Pool >
+void chain_fn( Pool & pool, boost::atomic< int > & count, int n)
+{
+	count.fetch_add( 1);
+	if ( 1 < n)
+		pool.submit( boost::bind( chain_fn< Pool >, boost::ref( pool), boost::ref( count), n - 1) );
+}
+
+// fills the run-next slot, the worker-queue and the global queue of a
+// pool with one worker-thread, then starts a chain of n tasks - its
+// tasks are executed inline
+template< typename Pool >
+void fill_and_chain_fn( Pool & pool, boost::atomic< int > & count, int n)
+{
+	spawn_fn( pool, count, 3);
+	chain_fn( pool, count, n);
+}
+
+// check a full worker-queue overflows into the global queue
+void test_case_1()
+{
+	typedef tsk::static_pool< tsk::unbounded_fifo > pool_type;
+	pool_type pool( tsk::poolsize( 1) );
+	pool.worker_queue_capacity( tsk::worker_capacity( 2) );
+	BOOST_CHECK_EQUAL( pool.worker_queue_capacity(), std::size_t( 2) );
+	boost::atomic< int > count( 0);
+	tsk::task< void > t(
+		pool.submit(
+			boost::bind( spawn_fn< pool_type >, boost::ref( pool), boost::ref( count), 100) ) );
+	t.get();
+	pool.shutdown();
+	BOOST_CHECK_EQUAL( count.load(), 100);
+	tsk::statistics st( pool.statistics() );
+	BOOST_CHECK( 0 < st.spilled);
+	BOOST_CHECK_EQUAL( st.inlined, std::size_t( 0) );
+}
+
+// check a task is executed inline if the global queue is full too
+void test_case_2()
+{
+	typedef tsk::static_pool< tsk::bounded_fifo > pool_type;
+	pool_type pool(
+		tsk::poolsize( 1),
+		tsk::high_watermark( 4),
+		tsk::low_watermark( 2) );
+	pool.worker_queue_capacity( tsk::worker_capacity( 2) );
+	boost::atomic< int > count( 0);
+	tsk::task< void > t(
+		pool.submit(
+			boost::bind( spawn_fn< pool_type >, boost::ref( pool), boost::ref( count), 100) ) );
+	t.get();
+	pool.shutdown();
+	BOOST_CHECK_EQUAL( count.load(), 100);
+	tsk::statistics st( pool.statistics() );
+	BOOST_CHECK( 0 < st.spilled);
+	BOOST_CHECK( 0 < st.inlined);
+}
+
+// check inline executions do not nest without limit - a chain of
+// tasks each spawning its successor completes
+void test_case_3()
+{
+	typedef tsk::static_pool< tsk::bounded_fifo > pool_type;
+	pool_type pool(
+		tsk::poolsize( 1),
+		tsk::high_watermark( 1),
+		tsk::low_watermark( 1) );
+	pool.worker_queue_capacity( tsk::worker_capacity( 1) );
+	boost::atomic< int > count( 0);
+	tsk::task< void > t(
+		pool.submit(
+			boost::bind( fill_and_chain_fn< pool_type >, boost::ref( pool), boost::ref( count), 10000) ) );
+	t.get();
+	pool.shutdown();
+	BOOST_CHECK_EQUAL( count.load(), 10003);
+	BOOST_CHECK( 0 < pool.statistics().inlined);
+}
+
+boost::unit_test::test_suite * init_unit_test_suite( int, char* [])
+{
+	boost::unit_test::test_suite * test =
+		BOOST_TEST_SUITE("Boost.Task: worker-queue capacity test suite");
+
+	test->add( BOOST_TEST_CASE( & test_case_1) );
+	test->add( BOOST_TEST_CASE( & test_case_2) );
+	test->add( BOOST_TEST_CASE( & test_case_3) );
+
+	return test;
+}
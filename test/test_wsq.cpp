@@ -0,0 +1,243 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include <cstddef>
+#include <vector>
+
+#include <boost/atomic.hpp>
+#include <boost/bind.hpp>
+#include <boost/ref.hpp>
+#include <boost/test/unit_test.hpp>
+#include <boost/thread.hpp>
+#include <boost/thread/barrier.hpp>
+
+#include <boost/task/callable.hpp>
+#include <boost/task/context.hpp>
+#include <boost/task/detail/work.hpp>
+#include <boost/task/detail/worker_array.hpp>
+#include <boost/task/detail/wsq.hpp>
+
+namespace tsk = boost::tasks;
+
+typedef std::vector< boost::atomic< int > * >	hits_t;
+
+// the callables of the test deliver no result
+struct null_promise
+{
+	void set() {}
+};
+
+struct hit_fn
+{
+	hits_t		*	hits;
+	std::size_t		idx;
+
+	hit_fn( hits_t & hits_, std::size_t idx_) :
+		hits( & hits_), idx( idx_)
+	{}
+
+	void operator()()
+	{ ( * hits)[idx]->fetch_add( 1); }
+};
+
+struct hits_guard
+{
+	hits_t	&	hits;
+
+	hits_guard( hits_t & hits_, std::size_t n) :
+		hits( hits_)
+	{
+		for ( std::size_t i = 0; i < n; ++i)
+			hits.push_back( new boost::atomic< int >( 0) );
+	}
+
+	~hits_guard()
+	{
+		for ( std::size_t i = 0; i < hits.size(); ++i)
+			delete hits[i];
+	}
+};
+
+void push( tsk::detail::wsq & q, hits_t & hits, std::size_t idx)
+{
+	null_promise prom;
+	tsk::detail::work w(
+		tsk::callable( hit_fn( hits, idx), boost::move( prom), tsk::context() ) );
+	q.put( boost::move( w) );
+}
+
+// executes the callable of a work-item which was not started
+void execute( tsk::detail::work & w)
+{
+	tsk::detail::work::raw r( w.release() );
+	tsk::callable ca( r.ca);
+	ca();
+}
+
+void steal_fn(
+	tsk::detail::wsq & q,
+	tsk::detail::worker_registry & registry,
+	std::size_t idx,
+	boost::atomic< bool > & done,
+	boost::barrier & b)
+{
+	b.wait();
+	for (;;)
+	{
+		// the owner retires arrays while the thief reads them
+		bool stop( done.load() );
+		tsk::detail::worker_registry::reader r( registry, idx, true);
+		tsk::detail::work w;
+		if ( q.try_steal( w) ) execute( w);
+		else if ( stop) return;
+	}
+}
+
+// check growth - items are taken in LIFO order
+void test_case_1()
+{
+	tsk::detail::worker_registry registry( 1);
+	tsk::detail::wsq q( registry);
+	hits_t hits;
+	hits_guard g( hits, 1000);
+	std::size_t initial( q.capacity() );
+
+	for ( std::size_t i = 0; i < 1000; ++i)
+		push( q, hits, i);
+	BOOST_CHECK_EQUAL( q.size(), std::size_t( 1000) );
+	BOOST_CHECK( q.capacity() >= 1000);
+	BOOST_CHECK( q.capacity() > initial);
+
+	for ( std::size_t i = 1000; 0 < i; --i)
+	{
+		tsk::detail::work w;
+		BOOST_REQUIRE( q.try_take( w) );
+		execute( w);
+		BOOST_CHECK_EQUAL( hits[i - 1]->load(), 1);
+	}
+	BOOST_CHECK( q.empty() );
+}
+
+// check shrinking - a sparse deque halves its array, a drained deque
+// returns to the initial capacity
+void test_case_2()
+{
+	tsk::detail::worker_registry registry( 1);
+	tsk::detail::wsq q( registry);
+	hits_t hits;
+	hits_guard g( hits, 4096);
+	std::size_t initial( q.capacity() );
+
+	for ( std::size_t i = 0; i < 4096; ++i)
+		push( q, hits, i);
+	std::size_t peak( q.capacity() );
+	for ( std::size_t i = 0; i < 4000; ++i)
+	{
+		tsk::detail::work w;
+		BOOST_REQUIRE( q.try_take( w) );
+		execute( w);
+	}
+	BOOST_CHECK( q.capacity() < peak);
+	BOOST_CHECK( q.capacity() >= q.size() );
+
+	tsk::detail::work w;
+	while ( q.try_take( w) ) execute( w);
+	BOOST_CHECK( ! q.try_take( w) );
+	BOOST_CHECK_EQUAL( q.capacity(), initial);
+	for ( std::size_t i = 0; i < hits.size(); ++i)
+		BOOST_CHECK_EQUAL( hits[i]->load(), 1);
+}
+
+// check steal - items are stolen in FIFO order, batch steals move up
+// to half of the items into the thief's deque
+void test_case_3()
+{
+	tsk::detail::worker_registry registry( 2);
+	tsk::detail::wsq q( registry);
+	tsk::detail::wsq dst( registry);
+	hits_t hits;
+	hits_guard g( hits, 8);
+
+	for ( std::size_t i = 0; i < 8; ++i)
+		push( q, hits, i);
+
+	tsk::detail::worker_registry::reader r( registry, 1, true);
+	tsk::detail::work w;
+	BOOST_REQUIRE( q.try_steal( w) );
+	execute( w);
+	BOOST_CHECK_EQUAL( hits[0]->load(), 1);
+
+	BOOST_CHECK_EQUAL( q.try_steal( w, dst, 16), std::size_t( 4) );
+	execute( w);
+	BOOST_CHECK_EQUAL( hits[1]->load(), 1);
+	BOOST_CHECK_EQUAL( dst.size(), std::size_t( 3) );
+	BOOST_CHECK_EQUAL( q.size(), std::size_t( 3) );
+	while ( dst.try_take( w) ) execute( w);
+	while ( q.try_take( w) ) execute( w);
+	for ( std::size_t i = 0; i < hits.size(); ++i)
+		BOOST_CHECK_EQUAL( hits[i]->load(), 1);
+}
+
+// check concurrent steal - each item is executed exactly once while
+// the owner grows and shrinks its deque
+void test_case_4()
+{
+	std::size_t const thieves( 4);
+	std::size_t const items( 200000);
+	tsk::detail::worker_registry registry( thieves + 1);
+	tsk::detail::wsq q( registry);
+	hits_t hits;
+	hits_guard g( hits, items);
+	boost::atomic< bool > done( false);
+	boost::barrier b( thieves + 1);
+
+	boost::thread_group tg;
+	for ( std::size_t i = 1; i <= thieves; ++i)
+		tg.create_thread(
+			boost::bind(
+				steal_fn, boost::ref( q), boost::ref( registry), i,
+				boost::ref( done), boost::ref( b) ) );
+	b.wait();
+
+	std::size_t idx( 0);
+	while ( idx < items)
+	{
+		// bursts let the deque grow, draining lets it shrink
+		for ( std::size_t j = 0; j < 1000 && idx < items; ++j)
+			push( q, hits, idx++);
+		tsk::detail::work w;
+		for ( std::size_t j = 0; j < 900 && q.try_take( w); ++j)
+			execute( w);
+	}
+	tsk::detail::work w;
+	while ( q.try_take( w) ) execute( w);
+	done.store( true);
+	tg.join_all();
+
+	std::size_t lost( 0), twice( 0);
+	for ( std::size_t i = 0; i < items; ++i)
+	{
+		int n( hits[i]->load() );
+		if ( 0 == n) ++lost;
+		else if ( 1 < n) ++twice;
+	}
+	BOOST_CHECK_EQUAL( lost, std::size_t( 0) );
+	BOOST_CHECK_EQUAL( twice, std::size_t( 0) );
+	BOOST_CHECK( q.empty() );
+}
+
+boost::unit_test::test_suite * init_unit_test_suite( int, char* [])
+{
+	boost::unit_test::test_suite * test =
+		BOOST_TEST_SUITE("Boost.Task: work-stealing deque test suite");
+
+	test->add( BOOST_TEST_CASE( & test_case_1) );
+	test->add( BOOST_TEST_CASE( & test_case_2) );
+	test->add( BOOST_TEST_CASE( & test_case_3) );
+	test->add( BOOST_TEST_CASE( & test_case_4) );
+
+	return test;
+}